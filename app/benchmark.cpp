@@ -0,0 +1,304 @@
+#include "../include/FuncoesMain.hpp"
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+// Benchmarks dos caminhos quentes do solver, com sementes fixas:
+//   micro: getDistance por métrica, deltas, geradores *ComDelta e calcularCustoTotal (ns/op)
+//   macro: SA e SAReaquecimento completos em instâncias pequena, média e grande (movimentos/s)
+// Uso: tsp_bench [saida.csv] [referencia.csv]. A saída de um commit pode ser passada como
+// referência na execução de outro; a coluna Relativo é ns/op desta execução sobre a referência.
+// Cada grupo (uma instância carregada) roda num processo filho, e a coluna RSS é o pico de
+// memória desse processo (wait4), não o acumulado do benchmark inteiro.
+
+namespace {
+
+const std::string dirInstancias = "../data/TSPlib/";
+const uint64_t sementeBenchmark = 12345;
+
+struct ResultadoBenchmark {
+    std::string nome;
+    std::string instancia;
+    int dimensao = 0;
+    long long operacoes = 0;
+    double segundos = 0.0;
+    double movimentosPorSegundo = 0.0;   // geradores e execuções completas
+    double custo = 0.0;                  // execuções completas
+    long picoRssKB = 0;                  // do processo que rodou o grupo
+
+    double nsPorOp() const { return operacoes ? segundos * 1e9 / operacoes : 0.0; }
+};
+
+volatile double sumidouro;
+
+// Melhor de 'repeticoes' medições de 'operacoes' chamadas de f(k); a soma dos retornos vai para
+// sumidouro para o compilador não descartar as chamadas
+template <class F>
+double medir(long long operacoes, F&& f, int repeticoes = 3) {
+    double melhor = std::numeric_limits<double>::infinity();
+    for (int r = 0; r < repeticoes; ++r) {
+        double acumulado = 0.0;
+        auto inicio = std::chrono::steady_clock::now();
+        for (long long k = 0; k < operacoes; ++k) acumulado += f(k);
+        auto fim = std::chrono::steady_clock::now();
+        sumidouro = acumulado;
+        melhor = std::min(melhor, std::chrono::duration<double>(fim - inicio).count());
+    }
+    return melhor;
+}
+
+TSPInstance carregar(const std::string& nome, TSPInstance::DistanceMatrixType matriz) {
+    TSPInstance instancia;
+    instancia.loadFromFile(dirInstancias + nome + ".tsp");
+    instancia.buildDistanceMatrix(matriz);
+    return instancia;
+}
+
+const char* nomeMatriz(TSPInstance::DistanceMatrixType tipo) {
+    switch (tipo) {
+        case TSPInstance::DistanceMatrixType::INT32: return "INT32";
+        case TSPInstance::DistanceMatrixType::FLOAT32: return "FLOAT32";
+        default: return "Nenhuma";
+    }
+}
+
+class Benchmarks {
+private:
+    std::vector<ResultadoBenchmark> resultados;
+    std::map<std::string, double> referencia;
+
+    // No processo filho: só acumula; o pai mostra ao receber
+    void registrar(ResultadoBenchmark r) { resultados.push_back(std::move(r)); }
+
+    void mostrar(const ResultadoBenchmark& r) const {
+        std::cout << std::left << std::setw(34) << r.nome << std::setw(10) << r.instancia << std::right
+                  << std::setw(12) << std::fixed << std::setprecision(2) << r.nsPorOp();
+        if (r.movimentosPorSegundo > 0) std::cout << std::setw(14) << std::setprecision(0) << r.movimentosPorSegundo;
+        else std::cout << std::setw(14) << "-";
+        std::cout << std::setw(12) << r.picoRssKB;
+        auto it = referencia.find(r.nome + "/" + r.instancia);
+        if (it != referencia.end() && it->second > 0)
+            std::cout << std::setw(10) << std::setprecision(3) << r.nsPorOp() / it->second;
+        std::cout << std::defaultfloat << std::setprecision(6) << "\n";
+    }
+
+    // Campos de um resultado, uma linha por resultado, do filho para o pai
+    static std::string serializar(const ResultadoBenchmark& r) {
+        std::ostringstream out;
+        out << std::setprecision(17) << r.nome << "\t" << r.instancia << "\t" << r.dimensao << "\t" << r.operacoes
+            << "\t" << r.segundos << "\t" << r.movimentosPorSegundo << "\t" << r.custo << "\n";
+        return out.str();
+    }
+    static ResultadoBenchmark desserializar(const std::string& linha) {
+        std::vector<std::string> campos;
+        std::stringstream ss(linha);
+        for (std::string campo; std::getline(ss, campo, '\t');) campos.push_back(campo);
+        if (campos.size() != 7) throw std::runtime_error("Resultado de benchmark inválido: " + linha);
+        ResultadoBenchmark r;
+        r.nome = campos[0];
+        r.instancia = campos[1];
+        r.dimensao = std::stoi(campos[2]);
+        r.operacoes = std::stoll(campos[3]);
+        r.segundos = std::stod(campos[4]);
+        r.movimentosPorSegundo = std::stod(campos[5]);
+        r.custo = std::stod(campos[6]);
+        return r;
+    }
+
+public:
+    // Roda grupo() num processo filho, que devolve os resultados por um pipe; o pico de RSS
+    // vem do wait4 desse filho
+    template <class F>
+    void emProcessoFilho(F&& grupo) {
+        int fds[2];
+        if (pipe(fds) != 0) throw std::runtime_error("Erro ao criar pipe");
+        std::cout.flush();
+        pid_t pid = fork();
+        if (pid < 0) throw std::runtime_error("Erro no fork");
+        if (pid == 0) {
+            close(fds[0]);
+            int codigo = 0;
+            try {
+                resultados.clear();
+                grupo();
+                std::string dados;
+                for (const ResultadoBenchmark& r : resultados) dados += serializar(r);
+                for (size_t escrito = 0; escrito < dados.size();) {
+                    ssize_t n = write(fds[1], dados.data() + escrito, dados.size() - escrito);
+                    if (n <= 0) { codigo = 1; break; }
+                    escrito += n;
+                }
+            } catch (const std::exception& e) {
+                std::cerr << "Erro: " << e.what() << std::endl;
+                codigo = 1;
+            }
+            close(fds[1]);
+            _exit(codigo);
+        }
+
+        close(fds[1]);
+        std::string dados;
+        char buffer[4096];
+        for (ssize_t n; (n = read(fds[0], buffer, sizeof buffer)) > 0;) dados.append(buffer, n);
+        close(fds[0]);
+        int status = 0;
+        rusage uso{};
+        wait4(pid, &status, 0, &uso);
+        if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+            throw std::runtime_error("Benchmark falhou no processo filho");
+
+        std::stringstream linhas(dados);
+        for (std::string linha; std::getline(linhas, linha);) {
+            ResultadoBenchmark r = desserializar(linha);
+            r.picoRssKB = uso.ru_maxrss;
+            mostrar(r);
+            resultados.push_back(std::move(r));
+        }
+    }
+
+    void lerReferencia(const std::string& arquivo) {
+        std::ifstream in(arquivo);
+        if (!in) throw std::runtime_error("Erro ao abrir arquivo: " + arquivo);
+        std::string linha;
+        std::getline(in, linha);
+        while (std::getline(in, linha)) {
+            std::vector<std::string> campos;
+            std::stringstream ss(linha);
+            for (std::string campo; std::getline(ss, campo, ',');) campos.push_back(campo);
+            if (campos.size() >= 6) referencia[campos[0] + "/" + campos[1]] = std::stod(campos[5]);
+        }
+    }
+
+    void cabecalho() const {
+        std::cout << std::left << std::setw(34) << "Benchmark" << std::setw(10) << "Instância" << std::right
+                  << std::setw(12) << "ns/op" << std::setw(14) << "movimentos/s" << std::setw(12) << "RSS (KB)";
+        if (!referencia.empty()) std::cout << std::setw(10) << "Relativo";
+        std::cout << "\n";
+    }
+
+    // getDistance com índices sorteados de antemão (o custo do sorteio fica fora da medição)
+    void distancia(const std::string& nome, TSPInstance::DistanceMatrixType matriz, long long operacoes) {
+        TSPInstance instancia = carregar(nome, matriz);
+        const int n = instancia.getDimension();
+        Rng rng(sementeBenchmark);
+        std::vector<int> pares(2 * 4096);
+        for (int& c : pares) c = rng.inteiro(n);
+
+        double t = medir(operacoes, [&](long long k) {
+            const int* p = &pares[2 * (k & 4095)];
+            return instancia.getDistance(p[0], p[1]);
+        });
+        registrar({std::string("getDistance[") + nomeMatriz(matriz) + "]", nome, n, operacoes, t});
+    }
+
+    // Deltas, geradores e custo total sobre uma rota aleatória fixa
+    void vizinhancas(const std::string& nome, long long operacoes) {
+        TSPInstance instancia = carregar(nome, TSPInstance::DistanceMatrixType::INT32);
+        const int n = instancia.getDimension();
+        Rng rng(sementeBenchmark);
+        std::vector<int> rota = gerarRotaInicial(instancia, rng);
+        std::vector<int> pares(2 * 4096);
+        for (int& c : pares) c = rng.inteiro(n);
+
+        auto micro = [&](const std::string& bench, long long ops, bool movimentos, auto&& f) {
+            double t = medir(ops, f);
+            registrar({bench, nome, n, ops, t, movimentos ? ops / t : 0.0});
+        };
+
+        micro("calcularDeltaSwap", operacoes, false, [&](long long k) {
+            const int* p = &pares[2 * (k & 4095)];
+            return calcularDeltaSwap(rota, p[0], p[1], instancia);
+        });
+        micro("calcularDeltaInsertion", operacoes, false, [&](long long k) {
+            const int* p = &pares[2 * (k & 4095)];
+            return calcularDeltaInsertion(rota, p[0], p[1], instancia);
+        });
+        micro("gerarVizinhaSwapComDelta", operacoes, true,
+              [&](long long) { return gerarVizinhaSwapComDelta(rota, instancia, rng).delta; });
+        micro("gerarVizinhaInsertionComDelta", operacoes, true,
+              [&](long long) { return gerarVizinhaInsertionComDelta(rota, instancia, rng).delta; });
+        micro("gerarVizinha2optComDelta", operacoes, true,
+              [&](long long) { return gerarVizinha2optComDelta(rota, instancia, rng).delta; });
+        micro("gerarVizinhaOrOptComDelta", operacoes, true,
+              [&](long long) { return gerarVizinhaOrOptComDelta(rota, instancia, rng).delta; });
+
+        // Uma operação = uma rota inteira
+        long long rotas = std::max(1LL, operacoes / n);
+        micro("calcularCustoTotal", rotas, false,
+              [&](long long) { return calcularCustoTotal(instancia, rota); });
+    }
+
+    // Execução completa com o solver montado como em main (Config), sem rastro em arquivo
+    void execucao(const std::string& nome, const std::string& algoritmo) {
+        TSPInstance instancia;
+        instancia.loadFromFile(dirInstancias + nome + ".tsp");
+        prepararInstancia(instancia);
+
+        ParametrosSolver p;
+        p.algoritmo = algoritmo;
+        p.semente = sementeBenchmark;
+        std::unique_ptr<SimulatedAnnealing> solver = criarSolver(instancia, nullptr, p);
+
+        auto inicio = std::chrono::steady_clock::now();
+        std::vector<int> rota = solver->executar();
+        auto fim = std::chrono::steady_clock::now();
+
+        double t = std::chrono::duration<double>(fim - inicio).count();
+        long long movimentos = solver->getMovimentosPropostos();
+        registrar({algoritmo, nome, instancia.getDimension(), movimentos, t, movimentos / t,
+                   calcularCustoTotal(instancia, rota)});
+    }
+
+    void salvar(const std::string& arquivo) const {
+        std::ofstream out(arquivo);
+        if (!out) throw std::runtime_error("Erro ao abrir arquivo: " + arquivo);
+        out << "Benchmark,Instance,Dimension,Operations,Seconds,NsPerOp,MovesPerSecond,Cost,PeakRSSKB\n";
+        out << std::setprecision(10);
+        for (const auto& r : resultados)
+            out << r.nome << "," << r.instancia << "," << r.dimensao << "," << r.operacoes << ","
+                << r.segundos << "," << r.nsPorOp() << "," << r.movimentosPorSegundo << ","
+                << r.custo << "," << r.picoRssKB << "\n";
+        std::cout << "Resultados salvos em " << arquivo << "\n";
+    }
+};
+
+}
+
+int main(int argc, char** argv) {
+    using Tipo = TSPInstance::DistanceMatrixType;
+    try {
+        std::string saida = argc > 1 ? argv[1] : "../output/benchmark.csv";
+        Benchmarks bench;
+        if (argc > 2) bench.lerReferencia(argv[2]);
+        bench.cabecalho();
+
+        // getDistance por métrica (EUC_2D, GEO, EXPLICIT) e com a matriz pré-calculada
+        const long long opsDistancia = 20'000'000;
+        bench.emProcessoFilho([&] { bench.distancia("berlin52", Tipo::NONE, opsDistancia); });
+        bench.emProcessoFilho([&] { bench.distancia("gr96", Tipo::NONE, opsDistancia); });
+        bench.emProcessoFilho([&] { bench.distancia("brazil58", Tipo::NONE, opsDistancia); });
+        bench.emProcessoFilho([&] { bench.distancia("berlin52", Tipo::INT32, opsDistancia); });
+        bench.emProcessoFilho([&] { bench.distancia("berlin52", Tipo::FLOAT32, opsDistancia); });
+
+        // Pequena, média e grande
+        for (const char* nome : {"berlin52", "a280", "rl5915"})
+            bench.emProcessoFilho([&] { bench.vizinhancas(nome, 5'000'000); });
+        for (const char* nome : {"berlin52", "a280", "rl5915"}) {
+            bench.emProcessoFilho([&] { bench.execucao(nome, "SA"); });
+            bench.emProcessoFilho([&] { bench.execucao(nome, "SAReaquecimento"); });
+        }
+
+        bench.salvar(saida);
+    } catch (const std::exception& e) {
+        std::cerr << "Erro: " << e.what() << std::endl;
+        return 1;
+    }
+    return 0;
+}
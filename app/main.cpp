@@ -1,17 +1,56 @@
 #include "../include/FuncoesMain.hpp"
 #include "../include/TSPInstance.hpp"
 #include "../include/FuncoesAuxiliares.hpp"
+#include "../include/MultiStart.hpp"
+#include "../include/Ilhas.hpp"
+#include "../include/Especulacao.hpp"
+#include "../include/Experimentos.hpp"
 
 int main() {
     try {
+        if (!Config::manifestoExperimentos.empty()) {
+            Manifesto manifesto = lerManifesto(Config::manifestoExperimentos);
+            auto resultados = executarExperimentos(manifesto);
+            salvarResultadosExperimentos(manifesto.saida.empty() ? "../output/experimentos.csv" : manifesto.saida,
+                                         resultados);
+            return 0;
+        }
+
         TSPInstance instancia;
-        instancia.loadFromFile(Config::instanciaFile);
+        carregarInstancia(instancia);
+        prepararInstancia(instancia);
 
-        SA::VizinhancaFunc vizFunc = escolherVizinhanca();
-        auto [melhorRota, graphData] = executarAlgoritmo(instancia, vizFunc);
-        exibirResultados(instancia, melhorRota);
+        auto candidatos = criarListaCandidatos(instancia);
+        instancia.saveBinaryCache();
+
+        if (Config::multiStartCadeias > 1) {
+            auto resultados = executarMultiStart(instancia, candidatos.get(), Config::multiStartCadeias,
+                                                 Config::multiStartThreads, Config::semente);
+            exibirResumoMultiStart(resultados);
+            salvarCSV("../output/resultado.csv", resultados[melhorCadeia(resultados)].graphData);
+            return 0;
+        }
 
-        salvarCSV("../output/resultado.csv", graphData);
+        if (Config::modoIlhas) {
+            ResultadoIlhas melhor = compararIlhas(instancia, candidatos.get());
+            exibirResultados(instancia, melhor.melhorRota);
+            salvarCSV("../output/resultado.csv", melhor.graphData);
+            return 0;
+        }
+
+        if (Config::modoEspeculativo) {
+            compararEspeculacao(instancia, candidatos.get());
+            return 0;
+        }
+
+        std::unique_ptr<SimulatedAnnealing> solver = criarSolver(instancia, candidatos.get());
+        solver->setVerbose(true);
+        long long linhaRastro = configurarPontoControle(*solver);
+        auto rastro = criarRastro("../output/resultado", linhaRastro);
+        solver->setRastro(rastro);
+        std::vector<int> melhorRota = executarAlgoritmo(*solver);
+        rastro->fechar();
+        exibirResultados(instancia, melhorRota);
 
     } catch (const std::exception& e) {
         std::cerr << "Erro: " << e.what() << std::endl;
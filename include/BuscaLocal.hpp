@@ -0,0 +1,58 @@
+#ifndef BUSCA_LOCAL_HPP
+#define BUSCA_LOCAL_HPP
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+#include "TSPInstance.hpp"
+#include "ListaCandidatos.hpp"
+
+// Busca local 2-opt + Or-opt (segmentos de até 3 cidades, nas duas orientações) guiada pelas
+// listas de candidatos, com bits "não olhe": a fila começa com todas as cidades e só as pontas
+// das arestas alteradas por um movimento voltam a ela. A rota fica num vetor com as posições de
+// cada cidade; cada 2-opt inverte o lado mais curto e um Or-opt são dois ou três 2-opt
+class BuscaLocal {
+private:
+    const TSPInstance& instance;
+    const ListaCandidatos* candidatos;
+    std::unique_ptr<ListaCandidatos> proprias;   // sem candidatos do chamador, k = 10
+
+    int n = 0;
+    std::vector<int> rota, pos;
+
+    // Fila circular das cidades a examinar; naFila é o complemento do bit "não olhe"
+    std::vector<int> fila;
+    size_t inicioFila = 0, tamFila = 0;
+    std::vector<char> naFila;
+
+    double dist(int a, int b) const { return instance.getDistanceFast(a, b); }
+    int sucessor(int c) const { int p = pos[c] + 1; return rota[p == n ? 0 : p]; }
+    int antecessor(int c) const { int p = pos[c]; return rota[p == 0 ? n - 1 : p - 1]; }
+
+    void ativar(int c);
+    void inverter(int i, int j);
+    void mover2opt(int t1, int t2, int t3, int t4);
+    bool tentar2opt(int t1, double& custo);
+    bool tentarOrOpt(int t, double& custo);
+
+public:
+    BuscaLocal(const TSPInstance& instance, const ListaCandidatos* candidatos = nullptr);
+
+    // Leva a rota a um ótimo local, no lugar, atualizando custo; retorna os movimentos aplicados.
+    // Passado o prazo, para com a rota melhorada até ali
+    long long otimizar(std::vector<int>& rotaEntrada, double& custo,
+                       std::chrono::steady_clock::time_point prazo = std::chrono::steady_clock::time_point::max());
+};
+
+// Totais das buscas locais de uma execução, mostrados no resumo separados dos do SA
+struct ResumoBuscaLocal {
+    int chamadas = 0;
+    long long movimentos = 0;
+    double melhoria = 0;   // soma das reduções de custo
+    double segundos = 0;
+
+    void imprimir(std::ostream& out) const;
+};
+
+#endif
@@ -6,26 +6,135 @@
 
 namespace Config {
 
-    // Escolha do algoritmo: "SA" ou "SAReaquecimento"
+    // Escolha do algoritmo: "SA", "SAReaquecimento" ou "SATrocaReplicas"
     const std::string algoritmo = "SA";
 
     // Caminho da instância TSP
     const std::string instanciaFile = "../data/TSPlib/berlin52.tsp";
 
-    // Tipo de vizinhança: "Insertion" ou "Swap"
+    // Modo em lote: manifesto de experimentos (ver Experimentos.hpp); vazio = execução única
+    // com os parâmetros deste arquivo. Exemplo: "../data/experimentos.txt"
+    const std::string manifestoExperimentos = "";
+
+    // Cache binário da instância (.tspbin): cabeçalho, coordenadas, matriz de distâncias e listas
+    // de candidatos, validado pelo hash do .tsp; cacheDiretorio vazio grava ao lado do .tsp.
+    // Desligado por padrão: com a matriz o arquivo ocupa ~4 * n^2 bytes (~140 MB no rl5915)
+    const bool        cacheInstancias = false;
+    const std::string cacheDiretorio  = "../cache";
+
+    // Rastro da execução única (uma linha por nível de temperatura), gravado durante a execução
+    // por uma thread de fundo: "CSV" (../output/resultado.csv) ou "Binario" (../output/resultado.bin,
+    // colunar); grava um nível a cada rastro_aCadaNiveis e, com rastro_soMelhora, só quando o
+    // melhor custo muda (ver Rastro.hpp)
+    const std::string rastro_formato      = "CSV";
+    const int         rastro_aCadaNiveis  = 1;
+    const bool        rastro_soMelhora    = false;
+
+    // Controle da execução: limites de tempo (segundos) e de propostas, 0 = sem limite (o cronograma
+    // geométrico do SA e as fases do SAReaquecimento são comprimidos para caber no limite), e parada
+    // ao chegar a gapAlvo % acima do ótimo conhecido (getMelhoresResultados; negativo = desligado)
+    const double    tempoLimite     = 0.0;
+    const long long iteracoesLimite = 0;
+    const double    gapAlvo         = -1.0;
+
+    // Pontos de controle da execução única com SA ou SAReaquecimento (ver PontoControle.hpp):
+    // arquivo e intervalo em segundos; vazio = desligado. Com retomar, se o arquivo existir a
+    // execução continua dele (com os mesmos parâmetros do solver), e o rastro é cortado na linha
+    // em que o ponto foi gravado. Ao fim de uma execução não cancelada o arquivo é apagado
+    const std::string pontoControle          = "";
+    const double      pontoControleIntervalo = 60.0;
+    const bool        retomar                = true;
+
+    // Semente do gerador de números aleatórios do solver (mesma semente, mesma execução)
+    const unsigned long long semente = 12345;
+
+    // Núcleo do SA especializado em tempo de compilação pela métrica e pela vizinhança;
+    // false usa o caminho genérico com std::function (mesmos resultados, mais lento)
+    const bool nucleoEspecializado = true;
+
+    // Multi-start: número de cadeias independentes (1 = execução única) e de threads (0 = todos os núcleos)
+    const int multiStartCadeias = 1;
+    const int multiStartThreads = 0;
+
+    // Modelo de ilhas: cadeias em threads que trocam a melhor rota em anel a cada
+    // ilhas_intervaloMigracao níveis de temperatura. Executa uma vez para cada número de
+    // threads em ilhas_threads e compara o tempo até ilhas_gapAlvo (% acima do ótimo)
+    const bool modoIlhas = false;
+    const int  ilhas_intervaloMigracao = 10;
+    const double ilhas_gapAlvo = 2.0;
+    const std::vector<int> ilhas_threads = {1, 4, 16, 32};
+
+    // Avaliação especulativa (SA): com esp_trabalhadores > 1, nos níveis em que a aceitação do
+    // nível anterior ficou abaixo de esp_limiarAceitacao, lotes de propostas são avaliados em
+    // paralelo sobre a mesma rota e o primeiro aceito, na ordem da sequência, é aplicado
+    const int    esp_trabalhadores      = 1;
+    const int    esp_lotePorTrabalhador = 16;
+    const double esp_limiarAceitacao    = 0.05;
+    // Curva de speed-up: mede propostas/s a esp_tempMedicao para cada valor de esp_threads
+    const bool   modoEspeculativo = false;
+    const double esp_tempMedicao  = 5.0;
+    const std::vector<int> esp_threads = {1, 2, 4, 8, 16};
+
+    // Tipo de vizinhança: "Insertion", "Swap", "2-opt" ou "Or-opt"
     const std::string vizinhanca = "Insertion";
 
+    // Matriz de distâncias pré-calculada: "INT32" ou "FLOAT32" (cache das distâncias do TSPLIB,
+    // arredondadas, em int32 ou float) ou "Nenhuma" (calculadas a cada uso, com o mesmo arredondamento)
+    const std::string matrizDistancias = "INT32";
+    // Acima desta dimensão a matriz não é construída (memória ~ 4 * n^2 bytes)
+    const int matrizDistanciasMaxDim = 10000;
+
+    // Lista de candidatos: movimentos sorteados entre uma cidade e um de seus k vizinhos mais próximos
+    const bool usarListaCandidatos = false;
+    const int  candidatosK         = 10;
+
+    // Propostas do SA: "Sequencial", "MelhorDoLote" ou "PrimeiraAceitavel" (lotes de
+    // tamLotePropostas com deltas vetorizados; Swap, Insertion e 2-opt; com a lista de
+    // candidatos as propostas ficam no modo Sequencial)
+    const std::string modoPropostas    = "Sequencial";
+    const int         tamLotePropostas = 8;
+
+    // Rota inicial: "Aleatoria", "VizinhoMaisProximo", "Gulosa", "Hilbert" ou "Economias" (ver
+    // Construcao.hpp). Com uma rota construída o SA parte de sa_tempInicialConstruida (0 = sa_tempInicial)
+    const std::string rotaInicial              = "Aleatoria";
+    const double      sa_tempInicialConstruida = 100.0;
+
+    // Busca local 2-opt/Or-opt (BuscaLocal.hpp) na melhor rota ao fim de cada fase do
+    // SAReaquecimento e ao fim da execução
+    const bool buscaLocal = false;
+
+    // A partir desta dimensão a rota em lista de dois níveis substitui a rota em vetor
+    const int limiarRotaDuasCamadas = 10000;
+
     // Parâmetros do SA normal
     const double sa_tempInicial      = 1000.0;
     const double sa_taxaResfriamento = 0.995;
     const int    sa_iterPorTemp      = 1000;
 
+    // Cronograma do SA: "Geometrico" (sa_tempInicial, sa_iterPorTemp, até T = 1) ou "Adaptativo":
+    // T0 para aceitar sa_aceitacaoInicial das pioras amostradas, sa_iterPorCidade * n iterações por
+    // nível e parada quando a aceitação nos últimos sa_janelaParada níveis fica abaixo de sa_aceitacaoParada
+    const std::string sa_cronograma       = "Geometrico";
+    const double      sa_aceitacaoInicial = 0.8;
+    const double      sa_iterPorCidade    = 20.0;
+    const int         sa_janelaParada     = 10;
+    const double      sa_aceitacaoParada  = 0.001;
+
     // Parâmetros do SA com reaquecimento
     const std::vector<double> startTemp   = {1000.0, 500.0, 1000.0, 250.0};
     const std::vector<double> endTemp     = {100.0, 50.0, 25.0, 1.0};
     const std::vector<double> coolingRate = {0.995, 0.99, 0.98, 0.9};
     const std::vector<int>    maxIters    = {1000, 1000, 1000, 1000};
 
+    // Parâmetros da troca de réplicas (parallel tempering): escada geométrica de
+    // pt_replicas temperaturas, pt_trocas rodadas de pt_iterPorTroca passos por réplica
+    const int    pt_replicas     = 16;
+    const double pt_tempMin      = 1.0;
+    const double pt_tempMax      = 100.0;
+    const int    pt_iterPorTroca = 1000;
+    const int    pt_trocas       = 500;
+    const int    pt_threads      = 0;   // 0 = uma thread por réplica
+
 }
 
 #endif
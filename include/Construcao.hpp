@@ -0,0 +1,31 @@
+#ifndef CONSTRUCAO_HPP
+#define CONSTRUCAO_HPP
+
+#include <string>
+#include <vector>
+#include "TSPInstance.hpp"
+#include "ListaCandidatos.hpp"
+#include "Rng.hpp"
+
+// Heurísticas de construção da rota inicial do SA:
+//   Aleatoria          permutação aleatória (gerarRotaInicial)
+//   VizinhoMaisProximo vizinho mais próximo a partir de uma cidade sorteada; procura primeiro na
+//                      lista de candidatos e, esgotada, numa grade sobre as coordenadas
+//   Gulosa             arestas das listas de candidatos em ordem crescente (grau <= 2, sem ciclos)
+//   Hilbert            ordem das cidades na curva de Hilbert
+//   Economias          economias de Clarke-Wright em relação à cidade mais central, sobre as
+//                      mesmas arestas candidatas
+// Na Gulosa e nas Economias os fragmentos que sobram são ligados pelo extremo mais próximo,
+// procurado numa grade sobre os extremos. Sem coordenadas (EXPLICIT), o vizinho mais próximo
+// varre todas as cidades, a ligação dos fragmentos varre os extremos (quadrática no número de
+// fragmentos) e Hilbert usa o vizinho mais próximo
+enum class TipoRotaInicial { Aleatoria, VizinhoMaisProximo, Gulosa, Hilbert, Economias };
+
+TipoRotaInicial tipoRotaInicial(const std::string& nome);
+const char* nomeRotaInicial(TipoRotaInicial tipo);
+
+// Sem candidatos, constrói listas com k = 10 quando a heurística precisa delas
+std::vector<int> construirRotaInicial(const TSPInstance& instance, TipoRotaInicial tipo, Rng& rng,
+                                      const ListaCandidatos* candidatos = nullptr);
+
+#endif
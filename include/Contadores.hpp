@@ -0,0 +1,86 @@
+#ifndef CONTADORES_HPP
+#define CONTADORES_HPP
+
+#include <chrono>
+#include <ostream>
+#include "FuncoesAuxiliares.hpp"
+
+// Contadores por nível de temperatura do SA e do SAReaquecimento, e por degrau e rodada na troca
+// de réplicas: propostas, aceitas de subida (delta > 0) e de descida, novos melhores e tempo do
+// nível. Compilar com -DSA_CONTADORES=0
+// (make DEFINES=-DSA_CONTADORES=0) remove toda a contagem; os campos de GraphData ficam em zero
+#ifndef SA_CONTADORES
+#define SA_CONTADORES 1
+#endif
+
+#if SA_CONTADORES
+
+class ContadoresNivel {
+private:
+    long long propostas = 0;
+    long long aceitosSubida = 0;
+    long long aceitosDescida = 0;
+    long long novosMelhores = 0;
+    std::chrono::steady_clock::time_point inicio;
+
+public:
+    void iniciar() {
+        propostas = aceitosSubida = aceitosDescida = novosMelhores = 0;
+        inicio = std::chrono::steady_clock::now();
+    }
+    void proposta(long long n = 1) { propostas += n; }
+    void aceito(double delta) {
+        if (delta > 0) ++aceitosSubida;
+        else ++aceitosDescida;
+    }
+    void novoMelhor() { ++novosMelhores; }
+
+    // Copia os contadores para a linha do nível
+    void preencher(GraphData& dados) const {
+        dados.proposals = propostas;
+        dados.accepted_uphill = aceitosSubida;
+        dados.accepted_downhill = aceitosDescida;
+        dados.new_best = novosMelhores;
+        dados.level_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - inicio).count();
+    }
+};
+
+#else
+
+class ContadoresNivel {
+public:
+    void iniciar() {}
+    void proposta(long long = 1) {}
+    void aceito(double) {}
+    void novoMelhor() {}
+    void preencher(GraphData&) const {}
+};
+
+#endif
+
+// Totais da execução, somados a cada nível registrado (ver SimulatedAnnealing::registrarNivel);
+// um nível congelado teve propostas e nenhuma aceita
+struct ResumoContadores {
+    long long niveis = 0;
+    long long niveisCongelados = 0;
+    long long propostas = 0;
+    long long aceitosSubida = 0;
+    long long aceitosDescida = 0;
+    long long novosMelhores = 0;
+    long long nanossegundos = 0;
+
+    void acumular(const GraphData& dados) {
+        ++niveis;
+        if (dados.proposals > 0 && dados.accepted_uphill + dados.accepted_downhill == 0) ++niveisCongelados;
+        propostas += dados.proposals;
+        aceitosSubida += dados.accepted_uphill;
+        aceitosDescida += dados.accepted_downhill;
+        novosMelhores += dados.new_best;
+        nanossegundos += dados.level_ns;
+    }
+
+    void imprimir(std::ostream& out) const;
+};
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef CONTROLE_EXECUCAO_HPP
+#define CONTROLE_EXECUCAO_HPP
+
+#include <functional>
+#include <limits>
+#include <vector>
+#include "FuncoesAuxiliares.hpp"
+
+// Controle de uma execução do solver (SimulatedAnnealing::setControle). Os limites são conferidos
+// a cada intervaloVerificacao propostas e ao fim de cada nível; no SA com cronograma geométrico e
+// nas fases do SAReaquecimento, o resfriamento é acelerado para que o cronograma inteiro caiba
+// no orçamento
+struct ControleExecucao {
+    double    tempoLimite     = 0.0;   // segundos de relógio; 0 = sem limite
+    long long iteracoesLimite = 0;     // propostas; 0 = sem limite
+    double    custoAlvo       = -std::numeric_limits<double>::infinity();   // para com melhor <= alvo
+    bool      comprimirCronograma = true;
+
+    // Chamados pela thread do solver ao fim de cada nível com a melhor rota até ali, ou só com o
+    // custo dela (sem copiar a rota)
+    using ProgressoFunc = std::function<void(const std::vector<int>& melhorRota, double melhorCusto, const GraphData& nivel)>;
+    using ProgressoCustoFunc = std::function<void(double melhorCusto, const GraphData& nivel)>;
+    ProgressoFunc progresso;
+    ProgressoCustoFunc progressoCusto;
+
+    static constexpr long long intervaloVerificacao = 256;
+
+    bool temOrcamento() const { return tempoLimite > 0 || iteracoesLimite > 0; }
+};
+
+enum class MotivoParada { Cronograma, TempoLimite, IteracoesLimite, CustoAlvo, Cancelado };
+
+inline const char* nomeMotivoParada(MotivoParada motivo) {
+    switch (motivo) {
+        case MotivoParada::TempoLimite: return "tempo limite";
+        case MotivoParada::IteracoesLimite: return "limite de iterações";
+        case MotivoParada::CustoAlvo: return "custo alvo atingido";
+        case MotivoParada::Cancelado: return "cancelado";
+        default: return "fim do cronograma";
+    }
+}
+
+#endif
@@ -0,0 +1,74 @@
+#ifndef CRONOGRAMA_HPP
+#define CRONOGRAMA_HPP
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Cronograma de temperatura do SA. Geometrico: T0 = temperaturaInicial, iteracoesPorTemperatura
+// por nível, até T <= 1. Adaptativo: T0 calibrado por amostragem de deltas para uma aceitação
+// inicial alvo, iterações por nível proporcionais a n e parada pela aceitação numa janela de níveis.
+// Nos dois o resfriamento é T *= taxaResfriamento
+enum class TipoCronograma { Geometrico, Adaptativo };
+
+TipoCronograma tipoCronograma(const std::string& nome);
+
+struct CronogramaAdaptativo {
+    double aceitacaoInicial = 0.8;     // fração alvo das propostas de piora aceitas em T0
+    int    amostras         = 1000;    // propostas sorteadas sobre a rota inicial para calibrar T0
+    double iterPorCidade    = 20.0;    // iterações por nível = iterPorCidade * n
+    int    janelaNiveis     = 10;      // níveis considerados no critério de parada
+    double aceitacaoParada  = 0.001;   // para quando a aceitação na janela fica abaixo disto
+};
+
+// T0 em que a média de exp(-delta/T) sobre os deltas de piora é 'alvo' (bisseção em escala log);
+// sem deltas positivos retorna 1
+double calibrarTemperaturaInicial(const std::vector<double>& deltasPiora, double alvo);
+
+// Aceitação acumulada nos últimos níveis
+class JanelaAceitacao {
+private:
+    std::vector<long long> aceitos, propostas;
+    size_t proximo = 0, preenchidos = 0;
+
+public:
+    explicit JanelaAceitacao(int niveis)
+        : aceitos(niveis > 0 ? niveis : 1, 0), propostas(niveis > 0 ? niveis : 1, 0) {}
+
+    void registrar(long long aceitosNivel, long long propostasNivel) {
+        aceitos[proximo] = aceitosNivel;
+        propostas[proximo] = propostasNivel;
+        proximo = (proximo + 1) % aceitos.size();
+        if (preenchidos < aceitos.size()) ++preenchidos;
+    }
+
+    // Estado para os pontos de controle: proximo, preenchidos, aceitos e propostas
+    std::vector<long long> salvarEstado() const {
+        std::vector<long long> dados{static_cast<long long>(proximo), static_cast<long long>(preenchidos)};
+        dados.insert(dados.end(), aceitos.begin(), aceitos.end());
+        dados.insert(dados.end(), propostas.begin(), propostas.end());
+        return dados;
+    }
+    void restaurarEstado(const std::vector<long long>& dados) {
+        if (dados.size() != 2 + 2 * aceitos.size())
+            throw std::runtime_error("Janela de aceitação do ponto de controle com tamanho diferente");
+        proximo = dados[0];
+        preenchidos = dados[1];
+        std::copy(dados.begin() + 2, dados.begin() + 2 + aceitos.size(), aceitos.begin());
+        std::copy(dados.begin() + 2 + aceitos.size(), dados.end(), propostas.begin());
+    }
+
+    // Só com a janela completa
+    bool abaixoDe(double limiar) const {
+        if (preenchidos < aceitos.size()) return false;
+        long long a = 0, p = 0;
+        for (size_t i = 0; i < aceitos.size(); ++i) {
+            a += aceitos[i];
+            p += propostas[i];
+        }
+        return p > 0 && a < limiar * p;
+    }
+};
+
+#endif
@@ -0,0 +1,76 @@
+#ifndef DIARIO_MOVIMENTOS_HPP
+#define DIARIO_MOVIMENTOS_HPP
+
+#include <algorithm>
+#include <vector>
+#include "Movimento.hpp"
+
+// Melhor rota de uma cadeia do SA sem copiar a rota a cada novo melhor. Guarda uma rota de
+// referência e o diário dos movimentos aceitos desde ela; o melhor é a referência mais os
+// movimentos até a marca, e novaMelhor só move a marca. A rota é materializada sob demanda
+// (melhor), reaplicando esses movimentos. Se o diário chega ao limite, os movimentos até a marca
+// são reaplicados; se ainda assim restarem muitos, o diário é descartado e o próximo novo melhor
+// volta a ser uma cópia da rota atual (uma cópia a cada limite movimentos aceitos, no máximo)
+template <class RotaT>
+class DiarioMovimentos {
+private:
+    RotaT referencia;
+    std::vector<Movimento> movimentos;
+    size_t marca = 0;
+    size_t limite;
+    bool descartado = false;
+
+    void reaplicarAteMarca() {
+        for (size_t m = 0; m < marca; ++m) referencia.aplicar(movimentos[m]);
+        movimentos.erase(movimentos.begin(), movimentos.begin() + marca);
+        marca = 0;
+    }
+
+public:
+    static constexpr size_t movimentosPorCidade = 4;
+
+    explicit DiarioMovimentos(const RotaT& inicial)
+        : referencia(inicial), limite(std::max<size_t>(1024, movimentosPorCidade * inicial.size())) {}
+
+    // Movimento aceito, já aplicado à rota atual
+    void registrar(const Movimento& mov) {
+        if (descartado) return;
+        if (movimentos.size() == limite) {
+            reaplicarAteMarca();
+            if (movimentos.size() > limite / 2) {
+                movimentos.clear();
+                descartado = true;
+                return;
+            }
+        }
+        movimentos.push_back(mov);
+    }
+
+    // A rota atual é o novo melhor
+    void novaMelhor(const RotaT& atual) {
+        if (descartado) reiniciar(atual);
+        else marca = movimentos.size();
+    }
+
+    // A rota atual, que passa a ser também o melhor, foi trocada fora do diário
+    void reiniciar(const RotaT& atual) {
+        referencia = atual;
+        movimentos.clear();
+        marca = 0;
+        descartado = false;
+    }
+
+    // A rota atual vai ser trocada fora do diário sem ser o melhor: fixa o melhor na referência
+    void desviar() {
+        reaplicarAteMarca();
+        movimentos.clear();
+        descartado = true;
+    }
+
+    const RotaT& melhor() {
+        reaplicarAteMarca();
+        return referencia;
+    }
+};
+
+#endif
@@ -0,0 +1,33 @@
+#ifndef DISTANCIAS_LOTE_HPP
+#define DISTANCIAS_LOTE_HPP
+
+#include <vector>
+#include "TSPInstance.hpp"
+
+// Calcula muitas distâncias d(p[k], q[k]) de uma vez, com a mesma semântica de
+// TSPInstance::getDistanceFast. Instâncias EUC_2D usam um espelho das coordenadas em
+// estrutura de arrays (x[] e y[] separados) e um kernel vetorizado com gathers, escolhido em
+// tempo de execução (AVX2, SSE2 ou escalar). Com matriz INT32 ou sem matriz o kernel arredonda
+// com o nint do TSPLIB, floor(d + 0.5), e dá os mesmos valores da matriz sem acessá-la. As
+// demais métricas e a matriz FLOAT32 passam por getDistanceFast.
+class DistanciasLote {
+public:
+    enum class Isa { Escalar, SSE2, AVX2 };
+
+private:
+    const TSPInstance& instance;
+    bool usarCoordenadas = false;
+    std::vector<double> x, y;
+    Isa isa = Isa::Escalar;
+
+public:
+    // isaMaxima limita o conjunto de instruções (para comparar os kernels)
+    explicit DistanciasLote(const TSPInstance& instance, Isa isaMaxima = Isa::AVX2);
+
+    void calcular(const int* p, const int* q, int m, double* saida) const;
+
+    Isa getIsa() const { return isa; }
+    bool usaCoordenadas() const { return usarCoordenadas; }
+};
+
+#endif
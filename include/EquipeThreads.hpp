@@ -0,0 +1,90 @@
+#ifndef EQUIPE_THREADS_HPP
+#define EQUIPE_THREADS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Equipe fixa de threads para rodadas curtas e frequentes (microssegundos): a cada rodada
+// todas executam a mesma tarefa com o próprio índice. As auxiliares esperam a próxima rodada
+// girando com yield por até esperaAtiva, porque acordar uma thread dormindo custaria mais que
+// a rodada inteira; sem rodadas nesse tempo, dormem numa variável de condição e deixam os
+// núcleos livres. Para tarefas longas e independentes, use PoolThreads.
+class EquipeThreads {
+private:
+    static constexpr std::chrono::microseconds esperaAtiva{200};
+
+    std::vector<std::thread> threads;
+    std::atomic<unsigned> rodada{0};
+    std::atomic<int> pendentes{0};
+    std::atomic<bool> encerrando{false};
+    const std::function<void(int)>* tarefa = nullptr;
+
+    // Auxiliares dormindo; executar só toma o mutex para acordá-las
+    std::atomic<int> dormindo{0};
+    std::mutex mtx;
+    std::condition_variable acordar;
+
+    void trabalhar(int id) {
+        unsigned vista = 0;
+        for (;;) {
+            unsigned atual;
+            auto inicioEspera = std::chrono::steady_clock::now();
+            while ((atual = rodada.load(std::memory_order_acquire)) == vista) {
+                if (encerrando.load(std::memory_order_relaxed)) return;
+                if (std::chrono::steady_clock::now() - inicioEspera < esperaAtiva) {
+                    std::this_thread::yield();
+                    continue;
+                }
+                // dormindo e rodada em ordem sequencial: ou executar vê esta thread dormindo,
+                // ou a verificação abaixo vê a rodada nova
+                std::unique_lock<std::mutex> lock(mtx);
+                dormindo.fetch_add(1);
+                acordar.wait(lock, [&] { return rodada.load() != vista || encerrando.load(); });
+                dormindo.fetch_sub(1);
+            }
+            vista = atual;
+            (*tarefa)(id);
+            pendentes.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+public:
+    // tamanho: número total de participantes, incluindo a thread que chama executar()
+    explicit EquipeThreads(int tamanho) {
+        for (int id = 1; id < tamanho; ++id) threads.emplace_back(&EquipeThreads::trabalhar, this, id);
+    }
+
+    EquipeThreads(const EquipeThreads&) = delete;
+    EquipeThreads& operator=(const EquipeThreads&) = delete;
+
+    ~EquipeThreads() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            encerrando.store(true);
+        }
+        acordar.notify_all();
+        for (std::thread& t : threads) t.join();
+    }
+
+    int size() const { return threads.size() + 1; }
+
+    // Executa f(0..size()-1), a parte 0 na thread chamadora, e espera todas terminarem
+    void executar(const std::function<void(int)>& f) {
+        tarefa = &f;
+        pendentes.store(threads.size(), std::memory_order_relaxed);
+        rodada.fetch_add(1);
+        if (dormindo.load() > 0) {
+            std::lock_guard<std::mutex> lock(mtx);
+            acordar.notify_all();
+        }
+        f(0);
+        while (pendentes.load(std::memory_order_acquire) > 0) std::this_thread::yield();
+    }
+};
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef ESPECULACAO_HPP
+#define ESPECULACAO_HPP
+
+#include <algorithm>
+#include <functional>
+#include <vector>
+#include "TSPInstance.hpp"
+#include "ListaCandidatos.hpp"
+#include "Movimento.hpp"
+#include "Rng.hpp"
+#include "EquipeThreads.hpp"
+
+// Avaliação especulativa de um lote de propostas sobre a mesma rota. O trabalhador w propõe
+// as posições w*L .. w*L+L-1 da sequência, cada uma com o próprio teste de Metropolis, e
+// para no primeiro aceito. Vale o primeiro aceito na ordem da sequência; o resto do lote é
+// descartado. Como uma proposta rejeitada não muda a rota, a cadeia tem a mesma distribuição
+// da sequencial (com outro fluxo de números aleatórios, fixo para cada número de trabalhadores).
+template <class RotaT, class Gerador>
+class AvaliadorEspeculativo {
+private:
+    struct alignas(64) Trabalhador {
+        Rng rng;
+        Movimento mov;
+        int aceito;   // índice no trecho do primeiro aceito, ou -1
+    };
+
+    const Gerador& gerar;
+    const TSPInstance& instance;
+    int lote;
+    std::vector<Trabalhador> trabalhadores;
+    EquipeThreads equipe;
+
+    // Parâmetros da rodada corrente, lidos pela tarefa da equipe
+    const RotaT* rota = nullptr;
+    double temperatura = 0.0;
+    int tamTrecho = 0;
+    int restantesRodada = 0;
+    std::function<void(int)> tarefa;
+
+    // O trecho do trabalhador não passa da posição 'restantes' da sequência
+    void avaliarTrecho(int w) {
+        Trabalhador& t = trabalhadores[w];
+        t.aceito = -1;
+        const int fim = std::min(tamTrecho, restantesRodada - w * tamTrecho);
+        for (int p = 0; p < fim; ++p) {
+            Movimento mov = gerar(*rota, instance, t.rng);
+            if (mov.delta < 0 || mov.delta < temperatura * t.rng.exponencial()) {
+                t.mov = mov;
+                t.aceito = p;
+                return;
+            }
+        }
+    }
+
+public:
+    // Os geradores dos trabalhadores são semeados a partir de rng
+    AvaliadorEspeculativo(const Gerador& gerar, const TSPInstance& instance,
+                          int numTrabalhadores, int lotePorTrabalhador, Rng& rng)
+        : gerar(gerar), instance(instance), lote(std::max(1, lotePorTrabalhador)),
+          trabalhadores(numTrabalhadores), equipe(numTrabalhadores),
+          tarefa([this](int w) { avaliarTrecho(w); }) {
+        for (Trabalhador& t : trabalhadores) t.rng.semear(rng.proximo());
+    }
+
+    // Avalia até 'restantes' propostas (o último trecho é encurtado para não passar delas).
+    // Retorna quantas propostas a cadeia sequencial teria consumido, no máximo 'restantes'; se
+    // alguma foi aceita, ela vem em escolhido e aceito = true.
+    int avaliarLote(const RotaT& rotaAtual, double temp, int restantes, Movimento& escolhido, bool& aceito) {
+        int W = trabalhadores.size();
+        rota = &rotaAtual;
+        temperatura = temp;
+        tamTrecho = std::max(1, std::min(lote, (restantes + W - 1) / W));
+        restantesRodada = std::max(1, restantes);
+
+        equipe.executar(tarefa);
+
+        for (int w = 0; w < W; ++w) {
+            if (trabalhadores[w].aceito >= 0) {
+                escolhido = trabalhadores[w].mov;
+                aceito = true;
+                return w * tamTrecho + trabalhadores[w].aceito + 1;
+            }
+        }
+        aceito = false;
+        return std::min(W * tamTrecho, restantesRodada);
+    }
+};
+
+// Mede a vazão (propostas/s) do SA em temperaturas baixas para cada número de trabalhadores
+// em Config::esp_threads: uma execução sequencial completa dá a rota de partida, depois cada
+// configuração recoze a partir dela com Config::esp_tempMedicao, especulando em todos os níveis
+void compararEspeculacao(const TSPInstance& instancia, const ListaCandidatos* candidatos);
+
+#endif
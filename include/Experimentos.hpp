@@ -0,0 +1,63 @@
+#ifndef EXPERIMENTOS_HPP
+#define EXPERIMENTOS_HPP
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Modo em lote: executa todas as combinações instância x algoritmo x vizinhança x conjunto de
+// parâmetros x semente de um manifesto, sem recompilar. Formato do manifesto (uma chave por
+// linha, '#' inicia comentário, caminhos relativos ao diretório do manifesto):
+//   instancias  = ../data/TSPlib          diretórios (todos os .tsp) ou arquivos
+//   algoritmos  = SA SAReaquecimento
+//   vizinhancas = Insertion 2-opt
+//   sementes    = 1-5 42                   valores e intervalos a-b
+//   conjunto padrao =
+//   conjunto lento  = sa_taxaResfriamento=0.999 sa_iterPorTemp=2000
+//   threads     = 0                        0 = todos os núcleos
+//   saida       = ../output/experimentos.csv
+// Os conjuntos alteram campos de ParametrosSolver (FuncoesMain.hpp); listas como startTemp
+// usam vírgulas (startTemp=1000,500). Sem conjunto, vale um "padrao" com os valores de Config.
+
+struct ConjuntoParametros {
+    std::string nome;
+    std::vector<std::pair<std::string, std::string>> valores;
+};
+
+struct Manifesto {
+    std::vector<std::string> instancias;
+    std::vector<std::string> algoritmos;
+    std::vector<std::string> vizinhancas;
+    std::vector<ConjuntoParametros> conjuntos;
+    std::vector<uint64_t> sementes;
+    int threads = 0;
+    std::string saida;
+};
+
+struct ResultadoExperimento {
+    std::string instancia;
+    int dimensao;
+    std::string algoritmo;
+    std::string vizinhanca;
+    std::string conjunto;
+    uint64_t semente;
+    double custo;
+    double gap;          // % acima do ótimo conhecido; NaN se a instância não tem ótimo
+    double tempo;        // tempo de parede da execução, em segundos
+    long long movimentos;
+};
+
+// Lê e valida o manifesto (nomes de algoritmo, vizinhança e parâmetros)
+Manifesto lerManifesto(const std::string& arquivo);
+
+// Carrega cada instância uma vez (com matriz e lista de candidatos conforme Config) e executa
+// as combinações num pool de threads, das instâncias de maior DIMENSION para as menores.
+// Com mais de uma thread no pool, a troca de réplicas roda as réplicas em uma thread só.
+// Os resultados vêm na ordem do manifesto.
+std::vector<ResultadoExperimento> executarExperimentos(const Manifesto& manifesto);
+
+// Tabela consolidada: uma linha por execução, com custo, gap, tempo e movimentos por segundo
+void salvarResultadosExperimentos(const std::string& arquivo, const std::vector<ResultadoExperimento>& resultados);
+
+#endif
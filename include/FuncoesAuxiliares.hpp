@@ -3,27 +3,45 @@
 
 #include <vector>
 #include "TSPInstance.hpp"
+#include "Movimento.hpp"
+#include "Rng.hpp"
+#include "Rota.hpp"
+#include "RotaDuasCamadas.hpp"
+#include "ListaCandidatos.hpp"
+#include "GraphData.hpp"
 #include <algorithm>
-#include <cstdlib>
-#include <random>
-
-struct GraphData {
-    int iteration;
-    double temperature;
-    double cost;
-    double best_cost;
-};
 
 double calcularCusto(const std::vector<int>& rota, const TSPInstance& instance);
-std::vector<int> gerarRotaInicial(const TSPInstance& instance);
-std::vector<int> gerarVizinhaSwap(const std::vector<int>& rota);
-std::vector<int> gerarVizinhaInsertion(const std::vector<int>& rota);
+std::vector<int> gerarRotaInicial(const TSPInstance& instance, Rng& rng);
+std::vector<int> gerarVizinhaSwap(const std::vector<int>& rota, Rng& rng);
+std::vector<int> gerarVizinhaInsertion(const std::vector<int>& rota, Rng& rng);
 
 double calcularDeltaInsertion(const std::vector<int>& rota, int pos_remover, int pos_inserir, const TSPInstance& instance);
-std::pair<std::vector<int>, double> gerarVizinhaInsertionComDelta(const std::vector<int>& rota, double custoAtual, const TSPInstance& instance);
+Movimento gerarVizinhaInsertionComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng);
 
 double calcularDeltaSwap(const std::vector<int>& rota, int i, int j, const TSPInstance& instance);
-std::pair<std::vector<int>, double> gerarVizinhaSwapComDelta(const std::vector<int>& rota, double custoAtual, const TSPInstance& instance);
+Movimento gerarVizinhaSwapComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng);
+
+double calcularDelta2opt(const std::vector<int>& rota, int i, int j, const TSPInstance& instance);
+Movimento gerarVizinha2optComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng);
+
+double calcularDeltaOrOpt(const std::vector<int>& rota, int i, int k, int j, bool invertido, const TSPInstance& instance);
+Movimento gerarVizinhaOrOptComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng);
+
+// Vizinhanças guiadas pela lista de candidatos: sorteiam uma cidade a e um vizinho próximo b
+// e propõem o movimento que torna a e b adjacentes
+Movimento gerarVizinhaSwapCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng);
+Movimento gerarVizinhaInsertionCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng);
+Movimento gerarVizinha2optCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng);
+Movimento gerarVizinhaOrOptCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng);
+
+// Vizinhança sobre a rota em dois níveis, descrita por cidades (ver Movimento);
+// com lista de candidatos, b é sorteado entre os vizinhos próximos de a
+Movimento gerarVizinhaDuasCamadas(const RotaDuasCamadas& rota, TipoMovimento tipo,
+                                  const ListaCandidatos* candidatos, const TSPInstance& instance, Rng& rng);
+
+// Aplica na rota um movimento aceito
+void aplicarMovimento(std::vector<int>& rota, const Movimento& mov);
 double calcularCustoTotal(const TSPInstance& instance, const std::vector<int>& rota);
 
 #endif
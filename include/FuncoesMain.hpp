@@ -4,18 +4,107 @@
 #include <vector>
 #include <string>
 #include <unordered_map>
+#include <memory>
 #include "../include/TSPInstance.hpp"
 #include "../include/SA.hpp"
 #include "../include/SAReaquecimento.hpp"
+#include "../include/SATrocaReplicas.hpp"
+#include "../include/SAEspecializado.hpp"
 #include "../include/FuncoesAuxiliares.hpp"
+#include "../include/ListaCandidatos.hpp"
 #include "../include/Config.hpp"
+#include "../include/Rastro.hpp"
 
-// Seleciona a função de vizinhança
-SA::VizinhancaFunc escolherVizinhanca();
+// Parâmetros de criação do solver; os valores padrão são os de Config.hpp. O modo em lote
+// (Experimentos.hpp) monta um conjunto destes para cada combinação do manifesto
+struct ParametrosSolver {
+    std::string algoritmo  = Config::algoritmo;
+    std::string vizinhanca = Config::vizinhanca;
+    uint64_t    semente    = Config::semente;
 
-// Executa o algoritmo e retorna melhor rota + dados do gráfico
-std::pair<std::vector<int>, std::vector<GraphData>> executarAlgoritmo(
-    const TSPInstance& instancia, SA::VizinhancaFunc vizFunc);
+    double sa_tempInicial      = Config::sa_tempInicial;
+    double sa_taxaResfriamento = Config::sa_taxaResfriamento;
+    int    sa_iterPorTemp      = Config::sa_iterPorTemp;
+
+    std::string rotaInicial              = Config::rotaInicial;
+    double      sa_tempInicialConstruida = Config::sa_tempInicialConstruida;
+    bool        buscaLocal               = Config::buscaLocal;
+
+    std::string sa_cronograma       = Config::sa_cronograma;
+    double      sa_aceitacaoInicial = Config::sa_aceitacaoInicial;
+    double      sa_iterPorCidade    = Config::sa_iterPorCidade;
+    int         sa_janelaParada     = Config::sa_janelaParada;
+    double      sa_aceitacaoParada  = Config::sa_aceitacaoParada;
+
+    std::vector<double> startTemp   = Config::startTemp;
+    std::vector<double> endTemp     = Config::endTemp;
+    std::vector<double> coolingRate = Config::coolingRate;
+    std::vector<int>    maxIters    = Config::maxIters;
+
+    int    pt_replicas     = Config::pt_replicas;
+    double pt_tempMin      = Config::pt_tempMin;
+    double pt_tempMax      = Config::pt_tempMax;
+    int    pt_iterPorTroca = Config::pt_iterPorTroca;
+    int    pt_trocas       = Config::pt_trocas;
+    int    pt_threads      = Config::pt_threads;
+
+    double    tempoLimite     = Config::tempoLimite;
+    long long iteracoesLimite = Config::iteracoesLimite;
+    double    gapAlvo         = Config::gapAlvo;
+};
+
+// Constrói os caches da instância (matriz de distâncias) conforme Config
+void prepararInstancia(TSPInstance& instancia);
+
+// Carrega a instância (Config::instanciaFile por padrão), usando o cache binário (.tspbin)
+// se Config::cacheInstancias
+void carregarInstancia(TSPInstance& instancia, const std::string& arquivo = Config::instanciaFile);
+
+// Constrói a lista de candidatos se Config::usarListaCandidatos (senão retorna nullptr);
+// as listas ficam guardadas na instância para o cache binário
+std::unique_ptr<ListaCandidatos> criarListaCandidatos(TSPInstance& instancia);
+
+// Seleciona a função de vizinhança; com lista de candidatos, usa a versão guiada por ela
+SA::VizinhancaFunc escolherVizinhanca(const ListaCandidatos* candidatos = nullptr,
+                                      const std::string& vizinhanca = Config::vizinhanca);
+
+// Converte o nome da vizinhança em Config::vizinhanca no tipo de movimento
+TipoMovimento tipoVizinhanca(const std::string& nome);
+
+// Vizinhança para a rota em dois níveis, usada pelas instâncias acima de Config::limiarRotaDuasCamadas
+SA::VizinhancaDuasCamadasFunc escolherVizinhancaDuasCamadas(const ListaCandidatos* candidatos = nullptr,
+                                                            const std::string& vizinhanca = Config::vizinhanca);
+
+// Cria o solver de p.algoritmo com as vizinhanças via std::function; candidatos são os que as
+// vizinhanças usam, se usam (rota inicial, busca local, sem propostas em lote)
+std::unique_ptr<SimulatedAnnealing> criarSolverGenerico(
+    const TSPInstance& instancia, SA::VizinhancaFunc vizFunc,
+    SA::VizinhancaDuasCamadasFunc vizDuasCamadas = nullptr, const ParametrosSolver& p = ParametrosSolver(),
+    const ListaCandidatos* candidatos = nullptr);
+
+// Cria o solver de p.algoritmo com o núcleo especializado: a política de distância
+// (matriz ou EdgeWeightType) e a vizinhança (p.vizinhanca) são escolhidas uma única vez aqui
+std::unique_ptr<SimulatedAnnealing> criarSolverEspecializado(const TSPInstance& instancia,
+                                                             const ListaCandidatos* candidatos = nullptr,
+                                                             const ParametrosSolver& p = ParametrosSolver());
+
+// Núcleo especializado ou genérico, conforme Config::nucleoEspecializado
+std::unique_ptr<SimulatedAnnealing> criarSolver(const TSPInstance& instancia,
+                                                const ListaCandidatos* candidatos = nullptr,
+                                                const ParametrosSolver& p = ParametrosSolver());
+
+// Executa o solver e retorna a melhor rota; os dados por nível vão para o rastro do solver
+// (ou ficam em getGraphData, se não houver rastro)
+std::vector<int> executarAlgoritmo(SimulatedAnnealing& solver);
+
+// Gravador do rastro em base + ".csv" ou ".bin", com formato e decimação de Config; com
+// continuarDe >= 0, continua o rastro existente a partir dessa linha (retomada)
+std::shared_ptr<GravadorRastro> criarRastro(const std::string& base, long long continuarDe = -1);
+
+// Liga os pontos de controle de Config no solver e, se Config::retomar e o arquivo existir,
+// prepara a retomada (recusada se os parâmetros do solver mudaram). Retorna a linha do rastro
+// em que continuar (-1 = rastro novo)
+long long configurarPontoControle(SimulatedAnnealing& solver);
 
 // Exibe resultados: custo, gap, instância
 void exibirResultados(const TSPInstance& instancia, const std::vector<int>& melhorRota);
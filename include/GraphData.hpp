@@ -1,11 +1,23 @@
 #ifndef GRAPH_DATA_HPP
 #define GRAPH_DATA_HPP
 
+// Uma linha do rastro: um nível de temperatura (ou, na troca de réplicas, um degrau por rodada)
 struct GraphData {
-    int iteration;
+    long long iteration;
     double temperature;
     double cost;
     double best_cost;
+    // Troca de réplicas: degrau da escada de temperaturas (0 = mais fria), taxa de
+    // aceitação da rodada e taxa acumulada de trocas com os degraus vizinhos
+    int rung = 0;
+    double acceptance_rate = 0.0;
+    double swap_rate = 0.0;
+    // Contadores do nível (na troca de réplicas, do degrau na rodada; ver Contadores.hpp)
+    long long proposals = 0;
+    long long accepted_uphill = 0;
+    long long accepted_downhill = 0;
+    long long new_best = 0;
+    long long level_ns = 0;
 };
 
 #endif
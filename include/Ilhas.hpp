@@ -0,0 +1,32 @@
+#ifndef ILHAS_HPP
+#define ILHAS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "TSPInstance.hpp"
+#include "ListaCandidatos.hpp"
+#include "FuncoesAuxiliares.hpp"
+
+// Resultado de uma execução do modelo de ilhas
+struct ResultadoIlhas {
+    int numIlhas;
+    std::vector<int> melhorRota;
+    double melhorCusto;
+    double tempoTotal;      // segundos até a última ilha terminar
+    double tempoAteAlvo;    // segundos até alguma ilha atingir custoAlvo (-1 se nenhuma atingiu)
+    std::vector<GraphData> graphData;   // da ilha com a melhor rota
+};
+
+// Modelo de ilhas: numIlhas cadeias de Config::algoritmo, uma por thread, compartilhando a
+// instância somente para leitura. A cada intervaloMigracao níveis de temperatura cada ilha
+// deposita sua melhor rota na caixa de correio da seguinte (anel) e adota a rota que
+// encontrar na própria caixa se for melhor que a atual. As caixas são ponteiros atômicos,
+// sem travas. Sementes: sementeBase + índice da ilha.
+ResultadoIlhas executarIlhas(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                             int numIlhas, int intervaloMigracao, double custoAlvo, uint64_t sementeBase);
+
+// Executa o modelo de ilhas para cada número de threads em Config::ilhas_threads e compara o
+// tempo até o gap alvo (Config::ilhas_gapAlvo) com o da cadeia única
+ResultadoIlhas compararIlhas(const TSPInstance& instancia, const ListaCandidatos* candidatos);
+
+#endif
@@ -0,0 +1,27 @@
+#ifndef LISTA_CANDIDATOS_HPP
+#define LISTA_CANDIDATOS_HPP
+
+#include <vector>
+#include "TSPInstance.hpp"
+
+// k vizinhos mais próximos de cada cidade, em ordem crescente de distância.
+// Instâncias com coordenadas usam uma k-d tree (O(n log n)); instâncias EXPLICIT
+// fazem seleção parcial de cada linha da matriz de pesos.
+class ListaCandidatos {
+private:
+    int k = 0;
+    std::vector<int> vizinhos;   // n x k, em ordem de linhas
+
+    void construirKDTree(const TSPInstance& instance);
+    void construirExplicit(const TSPInstance& instance);
+
+public:
+    ListaCandidatos() = default;
+    ListaCandidatos(const TSPInstance& instance, int k);
+
+    int getK() const { return k; }
+    const int* vizinhosDe(int cidade) const { return vizinhos.data() + static_cast<size_t>(cidade) * k; }
+    const std::vector<int>& getVizinhos() const { return vizinhos; }
+};
+
+#endif
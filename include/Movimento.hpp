@@ -0,0 +1,30 @@
+#ifndef MOVIMENTO_HPP
+#define MOVIMENTO_HPP
+
+// Tipos de movimento suportados pelas vizinhanças
+enum class TipoMovimento { Nenhum, Swap, Insertion, TwoOpt, OrOpt };
+
+// Descritor de um movimento proposto: posições na rota e variação de custo.
+// A rota só é alterada por aplicarMovimento, quando o movimento é aceito.
+//   Swap:      troca as cidades das posições i e j
+//   Insertion: remove a cidade da posição i e a reinsere no índice j da rota resultante
+//   TwoOpt:    remove as arestas (i, i+1) e (j, j+1) e inverte o trecho i+1..j (i < j)
+//   OrOpt:     move o trecho de k cidades que começa em i para entre as posições j e j+1,
+//              invertido ou não
+// Rotas sem posições (RotaDuasCamadas) descrevem o movimento pelas cidades a e b:
+//   Swap:      troca as cidades a e b
+//   Insertion: a passa a vir logo depois de b
+//   TwoOpt:    remove as arestas (a, próx a) e (b, próx b)
+//   OrOpt:     o trecho de k cidades que começa em a vai para logo depois de b
+struct Movimento {
+    TipoMovimento tipo = TipoMovimento::Nenhum;
+    int i = 0;
+    int j = 0;
+    int k = 0;
+    bool invertido = false;
+    double delta = 0.0;
+    int a = -1;
+    int b = -1;
+};
+
+#endif
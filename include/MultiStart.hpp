@@ -0,0 +1,32 @@
+#ifndef MULTI_START_HPP
+#define MULTI_START_HPP
+
+#include <cstdint>
+#include <vector>
+#include "TSPInstance.hpp"
+#include "ListaCandidatos.hpp"
+#include "FuncoesAuxiliares.hpp"
+
+// Resultado de uma cadeia independente do multi-start
+struct ResultadoCadeia {
+    uint64_t semente;
+    std::vector<int> rota;
+    double custo;
+    double tempo;   // tempo de parede da cadeia, em segundos
+    std::vector<GraphData> graphData;
+};
+
+// Executa numCadeias cadeias de Config::algoritmo num pool de numThreads threads
+// (0 = todos os núcleos). As cadeias compartilham a instância e a lista de candidatos,
+// somente para leitura; cada uma tem solver, rota, graph_data e semente próprios
+// (sementeBase + índice da cadeia).
+std::vector<ResultadoCadeia> executarMultiStart(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                                                int numCadeias, int numThreads, uint64_t sementeBase);
+
+// Tabela por cadeia (semente, custo, gap, tempo) e melhor / média / desvio padrão de custo e gap
+void exibirResumoMultiStart(const std::vector<ResultadoCadeia>& resultados);
+
+// Índice da cadeia de menor custo
+int melhorCadeia(const std::vector<ResultadoCadeia>& resultados);
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef POLITICAS_DISTANCIA_HPP
+#define POLITICAS_DISTANCIA_HPP
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "TSPInstance.hpp"
+
+// Políticas de distância: objetos-função d(i, j), um tipo por forma de armazenamento ou
+// métrica, com a mesma semântica de TSPInstance::getDistanceFast. Instanciar as vizinhanças
+// e o SA sobre elas troca o switch de getDistanceFast por código expandido em linha.
+// Guardam só ponteiros para os dados da instância, que deve sobreviver a elas.
+
+// Caminho genérico: delega a getDistanceFast (métricas sem política própria)
+struct DistanciaInstancia {
+    const TSPInstance* instancia;
+
+    explicit DistanciaInstancia(const TSPInstance& inst) : instancia(&inst) {}
+    double operator()(int i, int j) const { return instancia->getDistanceFast(i, j); }
+};
+
+// Matriz pré-calculada por buildDistanceMatrix (INT32 ou FLOAT32)
+template <class T>
+struct DistanciaMatriz {
+    const T* matriz;
+    size_t n;
+
+    explicit DistanciaMatriz(const TSPInstance& inst);
+    double operator()(int i, int j) const { return matriz[static_cast<size_t>(i) * n + j]; }
+};
+
+template <>
+inline DistanciaMatriz<int32_t>::DistanciaMatriz(const TSPInstance& inst)
+    : matriz(inst.getDistanceMatrixI32()), n(inst.getDimension()) {}
+
+template <>
+inline DistanciaMatriz<float>::DistanciaMatriz(const TSPInstance& inst)
+    : matriz(inst.getDistanceMatrixF32()), n(inst.getDimension()) {}
+
+// Métricas calculadas a partir das coordenadas
+struct DistanciaEuc2D {
+    const TSPInstance::City* cidades;
+
+    explicit DistanciaEuc2D(const TSPInstance& inst) : cidades(inst.getCities().data()) {}
+    double operator()(int i, int j) const { return TSPInstance::nint(TSPInstance::euclideanDistance2D(cidades[i], cidades[j])); }
+};
+
+struct DistanciaGeo {
+    const TSPInstance::City* cidades;
+
+    explicit DistanciaGeo(const TSPInstance& inst) : cidades(inst.getCities().data()) {}
+    double operator()(int i, int j) const {
+        // A fórmula GEO não dá zero para a mesma cidade
+        if (i == j) return 0.0;
+        return std::trunc(TSPInstance::geographicalDistance(cidades[i], cidades[j]));
+    }
+};
+
+struct DistanciaAtt {
+    const TSPInstance::City* cidades;
+
+    explicit DistanciaAtt(const TSPInstance& inst) : cidades(inst.getCities().data()) {}
+    double operator()(int i, int j) const { return TSPInstance::attDistance(cidades[i], cidades[j]); }
+};
+
+// Pesos EXPLICIT: matriz cheia (FULL_MATRIX) ou triângulo inferior empacotado
+struct DistanciaExplicitaCheia {
+    const int* pesos;
+    size_t n;
+
+    explicit DistanciaExplicitaCheia(const TSPInstance& inst)
+        : pesos(inst.getEdgeWeights().data()), n(inst.getDimension()) {}
+    double operator()(int i, int j) const { return pesos[static_cast<size_t>(i) * n + j]; }
+};
+
+struct DistanciaExplicitaEmpacotada {
+    const int* pesos;
+
+    explicit DistanciaExplicitaEmpacotada(const TSPInstance& inst) : pesos(inst.getEdgeWeights().data()) {}
+    double operator()(int i, int j) const {
+        if (i < j) std::swap(i, j);
+        return pesos[static_cast<size_t>(i) * (i + 1) / 2 + j];
+    }
+};
+
+#endif
@@ -0,0 +1,83 @@
+#ifndef PONTO_CONTROLE_HPP
+#define PONTO_CONTROLE_HPP
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Rng.hpp"
+#include "Contadores.hpp"
+#include "Rastro.hpp"
+
+// Estado de uma execução do SA ou do SAReaquecimento no início de um nível de temperatura:
+// o bastante para retomá-la e seguir exatamente como seguiria sem a interrupção (exceto com
+// avaliação especulativa, cujos geradores dos trabalhadores não são guardados)
+struct EstadoExecucao {
+    std::string algoritmo;   // "SA" ou "SAReaquecimento"
+    std::string instancia;
+    int dimensao = 0;
+    // Parâmetros que definem a execução ("chave=valor" por linha: semente, vizinhança,
+    // cronograma...); a retomada com parâmetros diferentes é recusada
+    std::string configuracao;
+
+    int fase = 0;                       // SAReaquecimento
+    double temperatura = 0.0;
+    int iterNivel = 0;                  // SA
+    long long iteracao = 0;             // propostas no SA, níveis no SAReaquecimento
+    long long proximaVerificacao = 0;   // SA (ver ControleExecucao)
+    int aceitosNivel = 0;               // SA (especulação)
+    double custoAtual = 0.0;
+    double melhorCusto = 0.0;
+
+    long long movimentosPropostos = 0;
+    long long niveisRegistrados = 0;
+    long long posicaoRastro = 0;        // linhas aceitas pelo rastro (SinkRastro::posicao)
+    EstadoDecimacao decimacao;          // SinkRastro::salvarDecimacao
+    double segundos = 0.0;              // tempo decorrido até o ponto de controle
+    ResumoContadores resumo;
+    Rng::Estado rng{};
+    std::vector<long long> janela;      // JanelaAceitacao do cronograma adaptativo
+
+    bool duasCamadas = false;
+    std::vector<int> rotaAtual;         // salvarEstado da rota (Rota ou RotaDuasCamadas)
+    std::vector<int> melhorRota;        // cidades em ordem
+};
+
+// Arquivo: "SARETOMA", uint32 versão e os campos de EstadoExecucao na ordem acima, little-endian;
+// strings e vetores levam antes o tamanho em uint64. A gravação vai para um temporário que é
+// renomeado sobre o caminho, então o ponto anterior vale até a troca
+void gravarPontoControle(const std::string& caminho, const EstadoExecucao& estado);
+EstadoExecucao lerPontoControle(const std::string& caminho);
+
+// Grava os pontos de controle por uma thread de fundo: enviar só entrega o estado, e um estado
+// ainda não gravado é substituído pelo mais novo. Antes de gravar, espera o rastro ter no arquivo
+// as linhas até a posição do estado, para que a retomada sempre encontre essas linhas
+class GravadorPontoControle {
+private:
+    std::string caminho;
+    std::unique_ptr<EstadoExecucao> pendente;
+    std::shared_ptr<SinkRastro> rastro;
+    bool encerrando = false;
+    std::mutex mtx;
+    std::condition_variable temEstado;
+    std::thread gravador;
+
+    void laco();
+
+public:
+    explicit GravadorPontoControle(const std::string& caminho);
+    // Grava o estado pendente e encerra a thread
+    ~GravadorPontoControle();
+    // Fim normal da execução: descarta o estado pendente, encerra a thread e apaga o arquivo,
+    // para que uma próxima execução com retomar comece do zero
+    void concluir();
+
+    GravadorPontoControle(const GravadorPontoControle&) = delete;
+    GravadorPontoControle& operator=(const GravadorPontoControle&) = delete;
+
+    void enviar(EstadoExecucao estado, std::shared_ptr<SinkRastro> destinoRastro);
+};
+
+#endif
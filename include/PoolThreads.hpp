@@ -0,0 +1,81 @@
+#ifndef POOL_THREADS_HPP
+#define POOL_THREADS_HPP
+
+#include <algorithm>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Pool fixo de threads com fila de tarefas. enviar() enfileira, aguardar() bloqueia até
+// a fila esvaziar e todas as tarefas em andamento terminarem. As tarefas não devem lançar
+// exceções (capture-as dentro da tarefa).
+class PoolThreads {
+private:
+    std::vector<std::thread> threads;
+    std::queue<std::function<void()>> tarefas;
+    std::mutex mtx;
+    std::condition_variable temTarefa;
+    std::condition_variable ocioso;
+    int emAndamento = 0;
+    bool encerrando = false;
+
+    void trabalhar() {
+        for (;;) {
+            std::function<void()> tarefa;
+            {
+                std::unique_lock<std::mutex> lock(mtx);
+                temTarefa.wait(lock, [this] { return encerrando || !tarefas.empty(); });
+                if (tarefas.empty()) return;
+                tarefa = std::move(tarefas.front());
+                tarefas.pop();
+                ++emAndamento;
+            }
+            tarefa();
+            {
+                std::lock_guard<std::mutex> lock(mtx);
+                --emAndamento;
+                if (emAndamento == 0 && tarefas.empty()) ocioso.notify_all();
+            }
+        }
+    }
+
+public:
+    // numThreads <= 0 usa o número de núcleos da máquina
+    explicit PoolThreads(int numThreads = 0) {
+        if (numThreads <= 0) numThreads = std::max(1u, std::thread::hardware_concurrency());
+        threads.reserve(numThreads);
+        for (int t = 0; t < numThreads; ++t) threads.emplace_back(&PoolThreads::trabalhar, this);
+    }
+
+    PoolThreads(const PoolThreads&) = delete;
+    PoolThreads& operator=(const PoolThreads&) = delete;
+
+    ~PoolThreads() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            encerrando = true;
+        }
+        temTarefa.notify_all();
+        for (std::thread& t : threads) t.join();
+    }
+
+    int size() const { return threads.size(); }
+
+    void enviar(std::function<void()> tarefa) {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            tarefas.push(std::move(tarefa));
+        }
+        temTarefa.notify_one();
+    }
+
+    void aguardar() {
+        std::unique_lock<std::mutex> lock(mtx);
+        ocioso.wait(lock, [this] { return emAndamento == 0 && tarefas.empty(); });
+    }
+};
+
+#endif
@@ -0,0 +1,204 @@
+#ifndef PROPOSTAS_EM_LOTE_HPP
+#define PROPOSTAS_EM_LOTE_HPP
+
+#include <algorithm>
+#include <vector>
+#include "DistanciasLote.hpp"
+#include "Movimento.hpp"
+#include "Rng.hpp"
+#include "Rota.hpp"
+#include "RotaDuasCamadas.hpp"
+
+// Modo de proposta do SA: uma por vez, ou lotes de propostas com os deltas calculados de
+// uma vez por DistanciasLote
+//   MelhorDoLote:      o teste de Metropolis é feito só com o menor delta do lote
+//   PrimeiraAceitavel: testa as propostas na ordem e aplica a primeira aceita
+enum class ModoPropostas { Sequencial, MelhorDoLote, PrimeiraAceitavel };
+
+// Lote de propostas aleatórias (Swap, Insertion ou 2-opt, sem listas de candidatos) sobre a
+// mesma rota. Cada proposta vira uma lista de termos +-d(p, q) com os mesmos termos de
+// calcularDelta*; as distâncias de todo o lote saem de uma chamada ao kernel.
+template <class RotaT>
+class PropostasEmLote {
+private:
+    static constexpr int maxTermos = 8;
+
+    const DistanciasLote& distancias;
+    TipoMovimento tipo;
+    ModoPropostas modo;
+    int tamanho;
+
+    std::vector<Movimento> movs;
+    std::vector<int> inicio;     // termos da proposta t: inicio[t] .. inicio[t+1]-1
+    std::vector<int> p, q;
+    std::vector<double> sinal, dist;
+
+    void termo(int a, int b, double s) {
+        p.push_back(a);
+        q.push_back(b);
+        sinal.push_back(s);
+    }
+
+    // Mesmos sorteios e termos de gerarVizinha*ComDelta
+    Movimento propor(const Rota& rota, Rng& rng) {
+        const std::vector<int>& r = rota.getCidades();
+        int n = r.size();
+        auto mod = [n](int x) { return (x + n) % n; };
+
+        switch (tipo) {
+            case TipoMovimento::Swap: {
+                int i = rng.inteiro(n);
+                int j = rng.inteiro(n);
+                while (i == j) j = rng.inteiro(n);
+                Movimento mov{TipoMovimento::Swap, i, j};
+
+                if (i > j) std::swap(i, j);
+                bool adjacentes = (i + 1 == j);
+                if (i == 0 && j == n - 1 && n > 2) {
+                    std::swap(i, j);
+                    adjacentes = true;
+                }
+                int a = r[i], b = r[j];
+                int a_ant = r[mod(i - 1)], a_prox = r[mod(i + 1)];
+                int b_ant = r[mod(j - 1)], b_prox = r[mod(j + 1)];
+                if (adjacentes) {
+                    termo(a_ant, b, 1); termo(a, b_prox, 1); termo(b, a, 1);
+                    termo(a_ant, a, -1); termo(b, b_prox, -1); termo(a, b, -1);
+                } else {
+                    termo(a_ant, b, 1); termo(b, a_prox, 1); termo(b_ant, a, 1); termo(a, b_prox, 1);
+                    termo(a_ant, a, -1); termo(a, a_prox, -1); termo(b_ant, b, -1); termo(b, b_prox, -1);
+                }
+                return mov;
+            }
+            case TipoMovimento::Insertion: {
+                int pos_remover = rng.inteiro(n);
+                int pos_inserir = rng.inteiro(n - 1);
+                while (pos_inserir == pos_remover) pos_inserir = rng.inteiro(n - 1);
+
+                int cidade = r[pos_remover];
+                auto semCidade = [&](int x) { return r[x < pos_remover ? x : x + 1]; };
+                int antes_inserir = semCidade(pos_inserir > 0 ? pos_inserir - 1 : n - 2);
+                int depois_inserir = semCidade(pos_inserir < n - 1 ? pos_inserir : 0);
+                termo(r[mod(pos_remover - 1)], r[mod(pos_remover + 1)], 1);
+                termo(antes_inserir, cidade, 1); termo(cidade, depois_inserir, 1);
+                termo(r[mod(pos_remover - 1)], cidade, -1); termo(cidade, r[mod(pos_remover + 1)], -1);
+                termo(antes_inserir, depois_inserir, -1);
+                return {TipoMovimento::Insertion, pos_remover, pos_inserir};
+            }
+            default: {
+                int i, j;
+                do {
+                    i = rng.inteiro(n);
+                    j = rng.inteiro(n);
+                    if (i > j) std::swap(i, j);
+                } while (j - i < 2 || (i == 0 && j == n - 1));
+
+                int a = r[i], b = r[i + 1], c = r[j], d = r[(j + 1) % n];
+                termo(a, c, 1); termo(b, d, 1); termo(a, b, -1); termo(c, d, -1);
+                return {TipoMovimento::TwoOpt, i, j};
+            }
+        }
+    }
+
+    // Mesmos sorteios e termos de gerarVizinhaDuasCamadas sem candidatos
+    Movimento propor(const RotaDuasCamadas& rota, Rng& rng) {
+        int a = rng.inteiro(rota.size());
+        int b = rng.inteiro(rota.size());
+        Movimento mov;
+        mov.tipo = tipo;
+
+        switch (tipo) {
+            case TipoMovimento::Swap: {
+                if (a == b) return {};
+                if (rota.proxima(b) == a) std::swap(a, b);
+                int pa = rota.anterior(a), na = rota.proxima(a);
+                int pb = rota.anterior(b), nb = rota.proxima(b);
+                if (na == b) {
+                    termo(pa, b, 1); termo(a, nb, 1); termo(pa, a, -1); termo(b, nb, -1);
+                } else {
+                    termo(pa, b, 1); termo(b, na, 1); termo(pb, a, 1); termo(a, nb, 1);
+                    termo(pa, a, -1); termo(a, na, -1); termo(pb, b, -1); termo(b, nb, -1);
+                }
+                break;
+            }
+            case TipoMovimento::Insertion: {
+                int pa = rota.anterior(a), na = rota.proxima(a);
+                if (b == a || b == pa) return {};
+                int v = rota.proxima(b);
+                termo(pa, na, 1); termo(pa, a, -1); termo(a, na, -1);
+                termo(b, a, 1); termo(a, v, 1); termo(b, v, -1);
+                break;
+            }
+            default: {
+                int na = rota.proxima(a), nb = rota.proxima(b);
+                if (a == b || na == b || nb == a) return {};
+                termo(a, b, 1); termo(na, nb, 1); termo(a, na, -1); termo(b, nb, -1);
+                break;
+            }
+        }
+        mov.a = a;
+        mov.b = b;
+        return mov;
+    }
+
+public:
+    PropostasEmLote(const DistanciasLote& distancias, TipoMovimento tipo, ModoPropostas modo, int tamanho)
+        : distancias(distancias), tipo(tipo), modo(modo), tamanho(std::max(1, tamanho)) {
+        movs.resize(this->tamanho);
+        inicio.resize(this->tamanho + 1);
+        p.reserve(this->tamanho * maxTermos);
+        q.reserve(this->tamanho * maxTermos);
+        sinal.reserve(this->tamanho * maxTermos);
+        dist.resize(this->tamanho * maxTermos);
+    }
+
+    // Só há termos para estes movimentos; Or-opt continua sequencial
+    static bool suporta(TipoMovimento tipo) {
+        return tipo == TipoMovimento::Swap || tipo == TipoMovimento::Insertion || tipo == TipoMovimento::TwoOpt;
+    }
+
+    // Gera e avalia até 'restantes' propostas. Retorna quantas foram consumidas; se alguma
+    // foi aceita, ela vem em escolhido e aceito = true. Propostas inválidas (movimento
+    // Nenhum, delta 0) contam como no gerador sequencial, mas não disputam o melhor do lote.
+    int avaliarLote(const RotaT& rota, double temperatura, int restantes, Rng& rng,
+                    Movimento& escolhido, bool& aceito) {
+        int m = std::max(1, std::min(tamanho, restantes));
+        p.clear();
+        q.clear();
+        sinal.clear();
+        for (int t = 0; t < m; ++t) {
+            inicio[t] = p.size();
+            movs[t] = propor(rota, rng);
+        }
+        inicio[m] = p.size();
+
+        distancias.calcular(p.data(), q.data(), p.size(), dist.data());
+        for (int t = 0; t < m; ++t) {
+            double delta = 0.0;
+            for (int k = inicio[t]; k < inicio[t + 1]; ++k) delta += sinal[k] * dist[k];
+            movs[t].delta = delta;
+        }
+
+        if (modo == ModoPropostas::PrimeiraAceitavel) {
+            for (int t = 0; t < m; ++t) {
+                if (movs[t].delta < 0 || movs[t].delta < temperatura * rng.exponencial()) {
+                    escolhido = movs[t];
+                    aceito = true;
+                    return t + 1;
+                }
+            }
+            aceito = false;
+            return m;
+        }
+
+        int melhor = -1;
+        for (int t = 0; t < m; ++t)
+            if (movs[t].tipo != TipoMovimento::Nenhum && (melhor < 0 || movs[t].delta < movs[melhor].delta))
+                melhor = t;
+        escolhido = melhor >= 0 ? movs[melhor] : Movimento{};
+        aceito = escolhido.delta < 0 || escolhido.delta < temperatura * rng.exponencial();
+        return m;
+    }
+};
+
+#endif
@@ -0,0 +1,113 @@
+#ifndef RASTRO_HPP
+#define RASTRO_HPP
+
+#include <string>
+#include <vector>
+#include <fstream>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <cstdint>
+#include "FuncoesAuxiliares.hpp"
+
+// Estado da decimação por degrau (ver GravadorRastro), guardado nos pontos de controle para que
+// a retomada grave as mesmas linhas que a execução sem interrupção
+struct EstadoDecimacao {
+    std::vector<long long> niveisDegrau;
+    std::vector<double> ultimoMelhor;
+    std::vector<GraphData> descartado;
+    std::vector<char> temDescartado;
+};
+
+// Rastro da execução: uma linha (GraphData) por nível de temperatura, enviada ao destino
+// durante a execução em vez de acumulada em graph_data (ver SimulatedAnnealing::setRastro)
+class SinkRastro {
+public:
+    virtual ~SinkRastro() = default;
+    // Chamada pela thread do solver ao fim de cada nível (uma vez por degrau na troca de réplicas)
+    virtual void registrar(const GraphData& dados) = 0;
+
+    // Linhas aceitas até aqui (a posição guardada nos pontos de controle)
+    virtual long long posicao() const { return 0; }
+    // Espera, fora da thread do solver, que as primeiras 'linhas' estejam gravadas no arquivo
+    virtual void aguardarGravacao(long long linhas) { (void)linhas; }
+
+    virtual EstadoDecimacao salvarDecimacao() const { return {}; }
+    virtual void restaurarDecimacao(const EstadoDecimacao& estado) { (void)estado; }
+};
+
+// "CSV": mesmo texto de salvarCSV. "Binario": colunar, little-endian:
+//   "SARASTRO", uint32 versão, uint32 colunas, por coluna char[15] nome + char tipo
+//   ('i' int32, 'l' int64, 'd' float64);
+//   depois blocos de uint32 linhas + uint32 reservado, seguidos dos valores de cada coluna em sequência
+enum class FormatoRastro { CSV, Binario };
+
+FormatoRastro formatoRastro(const std::string& nome);
+
+// Decimação por degrau: grava um nível a cada aCadaNiveis e, com soMelhora, só os níveis em que
+// o melhor custo mudou. O último nível descartado de cada degrau é gravado ao fechar
+struct DecimacaoRastro {
+    int  aCadaNiveis = 1;
+    bool soMelhora   = false;
+};
+
+// Grava o rastro em arquivo por uma thread de fundo. As linhas passam por um buffer circular de
+// tamanho fixo; se ele encher, registrar espera a gravação (o rastro nunca perde linhas aceitas).
+// Com continuarDe >= 0 (retomada de um ponto de controle), o arquivo existente é cortado nessa
+// linha e as novas linhas vão depois dela
+class GravadorRastro : public SinkRastro {
+private:
+    std::ofstream arquivo;
+    FormatoRastro formato;
+    DecimacaoRastro decimacao;
+
+    // Estado da decimação, por degrau (só a thread do solver)
+    EstadoDecimacao estadoDecimacao;
+
+    // Buffer circular entre o solver e a thread de gravação
+    std::vector<GraphData> anel;
+    size_t inicio = 0, ocupados = 0;
+    bool encerrando = false;
+    std::mutex mtx;
+    std::condition_variable temLinhas, temEspaco;
+    std::thread gravador;
+
+    // Linhas aceitas (thread do solver) e sincronização pedida por aguardarGravacao
+    long long aceitas = 0;
+    bool pedidoSincronizacao = false;
+    long long duraveis = 0;
+    bool terminou = false;
+    std::condition_variable sincronizado;
+
+    // Linhas ainda não gravadas (só a thread de gravação); no binário formam um bloco
+    std::vector<GraphData> pendentes;
+    long long gravadas = 0;
+
+    static constexpr size_t linhasPorBloco = 4096;
+
+    void enfileirar(const GraphData& dados);
+    void laco();
+    void gravarPendentes();
+
+public:
+    GravadorRastro(const std::string& caminho, FormatoRastro formato,
+                   DecimacaoRastro decimacao = DecimacaoRastro(), size_t capacidade = 1024,
+                   long long continuarDe = -1);
+    ~GravadorRastro() override;
+
+    GravadorRastro(const GravadorRastro&) = delete;
+    GravadorRastro& operator=(const GravadorRastro&) = delete;
+
+    void registrar(const GraphData& dados) override;
+    long long posicao() const override { return aceitas; }
+    void aguardarGravacao(long long linhas) override;
+    EstadoDecimacao salvarDecimacao() const override { return estadoDecimacao; }
+    void restaurarDecimacao(const EstadoDecimacao& estado) override { estadoDecimacao = estado; }
+
+    // Grava os níveis guardados pela decimação, esvazia o buffer e encerra a thread
+    void fechar();
+
+    long long linhasGravadas() const { return gravadas; }
+};
+
+#endif
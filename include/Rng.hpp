@@ -0,0 +1,92 @@
+#ifndef RNG_HPP
+#define RNG_HPP
+
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+// Gerador xoshiro256** com semente explícita, um por solver (sem estado global nem travas).
+// Também satisfaz UniformRandomBitGenerator, para uso com std::shuffle.
+class Rng {
+public:
+    using result_type = uint64_t;
+    static constexpr int TAM_LOTE = 256;
+
+private:
+    std::array<uint64_t, 4> s;
+
+    // Lote de exponenciais -log(u), consumido pelo critério de Metropolis
+    std::array<double, TAM_LOTE> lote;
+    int posLote = TAM_LOTE;
+
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    void reabastecerLote() {
+        for (double& e : lote) e = -std::log(uniformeAberta());
+        posLote = 0;
+    }
+
+public:
+    explicit Rng(uint64_t semente = 0x9E3779B97F4A7C15ULL) { semear(semente); }
+
+    // Preenche o estado com splitmix64, como recomendado pelos autores do xoshiro
+    void semear(uint64_t semente) {
+        for (uint64_t& palavra : s) {
+            uint64_t z = (semente += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            palavra = z ^ (z >> 31);
+        }
+        posLote = TAM_LOTE;
+    }
+
+    uint64_t proximo() {
+        const uint64_t resultado = rotl(s[1] * 5, 7) * 9;
+        const uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return resultado;
+    }
+
+    // Estado completo (palavras do xoshiro e lote de exponenciais), para os pontos de controle
+    struct Estado {
+        std::array<uint64_t, 4> s;
+        std::array<double, TAM_LOTE> lote;
+        int posLote;
+    };
+    Estado estado() const { return {s, lote, posLote}; }
+    void restaurar(const Estado& e) {
+        s = e.s;
+        lote = e.lote;
+        posLote = e.posLote;
+    }
+
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+    result_type operator()() { return proximo(); }
+
+    // Inteiro uniforme em [0, n), pela multiplicação de Lemire (n < 2^32)
+    int inteiro(int n) {
+        return static_cast<int>(((proximo() >> 32) * static_cast<uint64_t>(n)) >> 32);
+    }
+
+    // Uniforme em [0, 1)
+    double uniforme() { return (proximo() >> 11) * 0x1.0p-53; }
+
+    // Uniforme em (0, 1], segura para log
+    double uniformeAberta() { return ((proximo() >> 11) + 1) * 0x1.0p-53; }
+
+    // Variável exponencial de taxa 1 (-log u), servida a partir de um lote pré-calculado.
+    // Metropolis: aceitar se delta < T * exponencial()  <=>  u < exp(-delta / T)
+    double exponencial() {
+        if (posLote == TAM_LOTE) reabastecerLote();
+        return lote[posLote++];
+    }
+};
+
+#endif
@@ -0,0 +1,50 @@
+#ifndef ROTA_HPP
+#define ROTA_HPP
+
+#include <vector>
+#include "Movimento.hpp"
+
+// Rota em vetor com índice cidade -> posição mantido em sincronia,
+// para que as vizinhanças possam partir de uma cidade e achar sua posição em O(1)
+class Rota {
+private:
+    std::vector<int> cidades;
+    std::vector<int> posicoes;
+
+    void atualizarPosicoes(int inicio, int fim);
+
+public:
+    Rota() = default;
+    explicit Rota(const std::vector<int>& cidades);
+
+    int size() const { return cidades.size(); }
+    int cidade(int pos) const { return cidades[pos]; }
+    int posicao(int cidade) const { return posicoes[cidade]; }
+    int proxima(int cidade) const {
+        int pos = posicoes[cidade] + 1;
+        return cidades[pos == size() ? 0 : pos];
+    }
+    int anterior(int cidade) const {
+        int pos = posicoes[cidade];
+        return cidades[pos == 0 ? size() - 1 : pos - 1];
+    }
+
+    // Verdadeiro se, partindo de a no sentido da rota, chega-se a b antes de passar de c
+    bool entre(int a, int b, int c) const {
+        int pa = posicoes[a], pb = posicoes[b], pc = posicoes[c];
+        if (pa <= pc) return pa <= pb && pb <= pc;
+        return pb >= pa || pb <= pc;
+    }
+
+    const std::vector<int>& getCidades() const { return cidades; }
+    const std::vector<int>& paraVetor() const { return cidades; }
+
+    // Aplica um movimento aceito, atualizando só as posições do trecho alterado
+    void aplicar(const Movimento& mov);
+
+    // Estado para os pontos de controle: as cidades em ordem
+    std::vector<int> salvarEstado() const { return cidades; }
+    void restaurarEstado(const std::vector<int>& dados) { *this = Rota(dados); }
+};
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef ROTA_DUAS_CAMADAS_HPP
+#define ROTA_DUAS_CAMADAS_HPP
+
+#include <vector>
+#include "Movimento.hpp"
+
+// Rota em lista duplamente encadeada de dois níveis: as cidades são divididas em ~sqrt(n)
+// segmentos, cada um com um bit de inversão. proxima/anterior/entre custam O(1) e inverter
+// um trecho custa O(sqrt n), contra O(n) na rota em vetor.
+//
+// Oferece a mesma interface de consulta de Rota (size, proxima, anterior, entre, aplicar,
+// paraVetor), mas os movimentos são descritos pelas cidades a/b de Movimento, não por posições.
+class RotaDuasCamadas {
+private:
+    struct No {
+        int segmento;
+        int seq;    // número de sequência no segmento, crescente na ordem armazenada
+        int prox;   // vizinhos na ordem armazenada do segmento (-1 nas pontas)
+        int ant;
+    };
+
+    struct Segmento {
+        bool invertido;   // se verdadeiro, a rota percorre o segmento de ultimo para primeiro
+        int primeiro;
+        int ultimo;
+        int ordem;        // crescente ao longo da rota (com uma única volta)
+        int prox;         // segmentos vizinhos no sentido da rota
+        int ant;
+        int tam;
+    };
+
+    std::vector<No> nos;
+    std::vector<Segmento> segmentos;
+    int tamGrupo = 0;
+    bool precisaRebalancear = false;
+
+    int inicioSeg(int s) const { return segmentos[s].invertido ? segmentos[s].ultimo : segmentos[s].primeiro; }
+    int fimSeg(int s) const { return segmentos[s].invertido ? segmentos[s].primeiro : segmentos[s].ultimo; }
+    int seqRota(int c) const { return segmentos[nos[c].segmento].invertido ? -nos[c].seq : nos[c].seq; }
+
+    void construir(const std::vector<int>& cidades);
+    void tornarInicio(int x, int segProibido);
+    void moverParaFim(int origem, int destino, const std::vector<int>& trecho);
+    void moverParaInicio(int origem, int destino, const std::vector<int>& trecho);
+    void inverterNoSegmento(int a, int b);
+    void inverterSegmentos(int s1, int s2);
+    void trocarArestas(int t1, int t2, int t3, int t4);
+
+public:
+    RotaDuasCamadas() = default;
+    explicit RotaDuasCamadas(const std::vector<int>& cidades);
+
+    int size() const { return nos.size(); }
+
+    int proxima(int c) const {
+        const No& no = nos[c];
+        const Segmento& s = segmentos[no.segmento];
+        if (!s.invertido) return c == s.ultimo ? inicioSeg(s.prox) : no.prox;
+        return c == s.primeiro ? inicioSeg(s.prox) : no.ant;
+    }
+
+    int anterior(int c) const {
+        const No& no = nos[c];
+        const Segmento& s = segmentos[no.segmento];
+        if (!s.invertido) return c == s.primeiro ? fimSeg(s.ant) : no.ant;
+        return c == s.ultimo ? fimSeg(s.ant) : no.prox;
+    }
+
+    // Verdadeiro se, partindo de a no sentido da rota, chega-se a b antes de passar de c
+    bool entre(int a, int b, int c) const;
+
+    // Inverte o caminho de a até b (no sentido da rota); pode inverter o complemento,
+    // que dá o mesmo ciclo com a orientação trocada
+    void inverter(int a, int b);
+
+    void aplicar(const Movimento& mov);
+
+    std::vector<int> paraVetor() const;
+
+    // Estado para os pontos de controle: a estrutura inteira (nós, segmentos e tamanho do grupo),
+    // pois a orientação das inversões depende dela e a retomada tem de repetir a execução
+    std::vector<int> salvarEstado() const;
+    void restaurarEstado(const std::vector<int>& dados);
+};
+
+#endif
@@ -5,17 +5,26 @@
 
 class SA : public SimulatedAnnealing {
 public:
-    using VizinhancaFunc = std::function<std::pair<std::vector<int>, double>(
-        const std::vector<int>&, double, const TSPInstance&)>;
+    using VizinhancaFunc = std::function<Movimento(const Rota&, const TSPInstance&, Rng&)>;
+    using VizinhancaDuasCamadasFunc = std::function<Movimento(const RotaDuasCamadas&, const TSPInstance&, Rng&)>;
 
 private:
     VizinhancaFunc gerarVizinha;
+    VizinhancaDuasCamadasFunc gerarVizinhaDuasCamadas;
+
+protected:
+    // Laço do SA sobre qualquer rota e gerador; o caminho genérico usa std::function,
+    // o núcleo especializado (SAEspecializado.hpp) um gerador com a métrica fixa
+    template <class RotaT, class Gerador>
+    std::vector<int> executarCom(RotaT rotaAtual, const Gerador& gerar);
 
 public:
     SA(const TSPInstance& instance, double tempInicial, double taxaResfriamento,
-       int iterPorTemp, VizinhancaFunc vizinhanca)
+       int iterPorTemp, VizinhancaFunc vizinhanca,
+       VizinhancaDuasCamadasFunc vizinhancaDuasCamadas = nullptr)
        : SimulatedAnnealing(instance, tempInicial, taxaResfriamento, iterPorTemp),
-         gerarVizinha(vizinhanca) {}
+         gerarVizinha(vizinhanca),
+         gerarVizinhaDuasCamadas(vizinhancaDuasCamadas) {}
 
     std::vector<int> executar() override;
 };
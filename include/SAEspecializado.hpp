@@ -0,0 +1,107 @@
+#ifndef SA_ESPECIALIZADO_HPP
+#define SA_ESPECIALIZADO_HPP
+
+#include <cstdint>
+#include "SA.hpp"
+#include "SAReaquecimento.hpp"
+#include "SATrocaReplicas.hpp"
+#include "PoliticasDistancia.hpp"
+#include "Vizinhancas.hpp"
+
+// Núcleo especializado do SA: política de distância e tipo de movimento fixos em tempo
+// de compilação, no lugar de std::function + switch de getDistanceFast. O laço de
+// executarCom é o mesmo do caminho genérico, instanciado com este gerador.
+
+// Gerador de vizinhos com a mesma assinatura das funções de vizinhança; a rota (vetor
+// ou dois níveis) é escolhida pela sobrecarga
+template <class Dist, TipoMovimento Tipo>
+struct VizinhancaEspecializada {
+    Dist dist;
+    const ListaCandidatos* candidatos;
+
+    Movimento operator()(const Rota& rota, const TSPInstance&, Rng& rng) const {
+        if constexpr (Tipo == TipoMovimento::Swap)
+            return candidatos ? gerarVizinhaSwapCandidatos(rota, *candidatos, dist, rng)
+                              : gerarVizinhaSwapComDelta(rota.getCidades(), dist, rng);
+        else if constexpr (Tipo == TipoMovimento::Insertion)
+            return candidatos ? gerarVizinhaInsertionCandidatos(rota, *candidatos, dist, rng)
+                              : gerarVizinhaInsertionComDelta(rota.getCidades(), dist, rng);
+        else if constexpr (Tipo == TipoMovimento::TwoOpt)
+            return candidatos ? gerarVizinha2optCandidatos(rota, *candidatos, dist, rng)
+                              : gerarVizinha2optComDelta(rota.getCidades(), dist, rng);
+        else
+            return candidatos ? gerarVizinhaOrOptCandidatos(rota, *candidatos, dist, rng)
+                              : gerarVizinhaOrOptComDelta(rota.getCidades(), dist, rng);
+    }
+
+    Movimento operator()(const RotaDuasCamadas& rota, const TSPInstance&, Rng& rng) const {
+        return gerarVizinhaDuasCamadas(rota, Tipo, candidatos, dist, rng);
+    }
+};
+
+template <class Dist, TipoMovimento Tipo>
+class SAEspecializado : public SA {
+private:
+    VizinhancaEspecializada<Dist, Tipo> vizinhanca;
+
+public:
+    SAEspecializado(const TSPInstance& instance, double tempInicial, double taxaResfriamento,
+                    int iterPorTemp, const ListaCandidatos* candidatos = nullptr)
+        : SA(instance, tempInicial, taxaResfriamento, iterPorTemp, nullptr),
+          vizinhanca{Dist(instance), candidatos} {}
+
+    std::vector<int> executar() override;
+};
+
+template <class Dist, TipoMovimento Tipo>
+class SAReaquecimentoEspecializado : public SAReaquecimento {
+private:
+    VizinhancaEspecializada<Dist, Tipo> vizinhanca;
+
+public:
+    SAReaquecimentoEspecializado(const TSPInstance& instance,
+                                 const std::vector<double>& startTemp,
+                                 const std::vector<double>& endTemp,
+                                 const std::vector<double>& coolingRate,
+                                 const std::vector<int>& maxIters,
+                                 const ListaCandidatos* candidatos = nullptr)
+        : SAReaquecimento(instance, startTemp, endTemp, coolingRate, maxIters, nullptr),
+          vizinhanca{Dist(instance), candidatos} {}
+
+    std::vector<int> executar() override;
+};
+
+template <class Dist, TipoMovimento Tipo>
+class SATrocaReplicasEspecializado : public SATrocaReplicas {
+private:
+    VizinhancaEspecializada<Dist, Tipo> vizinhanca;
+
+public:
+    SATrocaReplicasEspecializado(const TSPInstance& instance, int numReplicas, double tempMin, double tempMax,
+                                 int iteracoesPorTroca, int numTrocas, int numThreads,
+                                 const ListaCandidatos* candidatos = nullptr)
+        : SATrocaReplicas(instance, numReplicas, tempMin, tempMax, iteracoesPorTroca, numTrocas, numThreads, nullptr),
+          vizinhanca{Dist(instance), candidatos} {}
+
+    std::vector<int> executar() override;
+};
+
+// Todas as combinações de métrica e vizinhança; executar() é definido e instanciado
+// explicitamente em SA.cpp, SAReaquecimento.cpp e SATrocaReplicas.cpp
+#define INSTANCIAR_VIZINHANCAS(Nucleo, Dist) \
+    template class Nucleo<Dist, TipoMovimento::Swap>; \
+    template class Nucleo<Dist, TipoMovimento::Insertion>; \
+    template class Nucleo<Dist, TipoMovimento::TwoOpt>; \
+    template class Nucleo<Dist, TipoMovimento::OrOpt>;
+
+#define INSTANCIAR_NUCLEOS(Nucleo) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaInstancia) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaMatriz<int32_t>) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaMatriz<float>) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaEuc2D) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaGeo) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaAtt) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaExplicitaCheia) \
+    INSTANCIAR_VIZINHANCAS(Nucleo, DistanciaExplicitaEmpacotada)
+
+#endif
@@ -7,13 +7,20 @@
 class SAReaquecimento : public SimulatedAnnealing {
     
 public:
-    using VizinhancaFunc = std::function<std::pair<std::vector<int>, double>(
-        const std::vector<int>&, double, const TSPInstance&)>;
+    using VizinhancaFunc = std::function<Movimento(const Rota&, const TSPInstance&, Rng&)>;
+    using VizinhancaDuasCamadasFunc = std::function<Movimento(const RotaDuasCamadas&, const TSPInstance&, Rng&)>;
 
 private:
     std::vector<double> startTemp, endTemp, coolingRate;
     std::vector<int> maxIters;
     VizinhancaFunc gerarVizinha;
+    VizinhancaDuasCamadasFunc gerarVizinhaDuasCamadas;
+
+protected:
+    // Laço do SA sobre qualquer rota e gerador; o caminho genérico usa std::function,
+    // o núcleo especializado (SAEspecializado.hpp) um gerador com a métrica fixa
+    template <class RotaT, class Gerador>
+    std::vector<int> executarCom(RotaT rotaAtual, const Gerador& gerar);
 
 public:
 SAReaquecimento(const TSPInstance& instance,
@@ -21,7 +28,8 @@ SAReaquecimento(const TSPInstance& instance,
                 const std::vector<double>& endTemp,
                 const std::vector<double>& coolingRate,
                 const std::vector<int>& maxIters,
-                VizinhancaFunc vizinhanca);
+                VizinhancaFunc vizinhanca,
+                VizinhancaDuasCamadasFunc vizinhancaDuasCamadas = nullptr);
 
     const std::vector<GraphData>& getGraphData() const { return graph_data; }
     std::vector<int> executar() override;
@@ -0,0 +1,42 @@
+#ifndef SA_TROCA_REPLICAS_HPP
+#define SA_TROCA_REPLICAS_HPP
+
+#include <functional>
+#include "SimulatedAnnealing.hpp"
+
+// Troca de réplicas (parallel tempering): K réplicas fazem Metropolis em paralelo, cada uma
+// num degrau de uma escada geométrica de temperaturas entre tempMin e tempMax. A cada
+// iteracoesPorTroca passos, pares de degraus vizinhos (alternando pares e ímpares) trocam
+// de estado com probabilidade min(1, exp((1/Ti - 1/Tj)(Ei - Ej))). A troca permuta os
+// índices das réplicas nos degraus, sem copiar rotas.
+class SATrocaReplicas : public SimulatedAnnealing {
+public:
+    using VizinhancaFunc = std::function<Movimento(const Rota&, const TSPInstance&, Rng&)>;
+    using VizinhancaDuasCamadasFunc = std::function<Movimento(const RotaDuasCamadas&, const TSPInstance&, Rng&)>;
+
+private:
+    int numReplicas;
+    double tempMin, tempMax;
+    int numTrocas;
+    int numThreads;
+    VizinhancaFunc gerarVizinha;
+    VizinhancaDuasCamadasFunc gerarVizinhaDuasCamadas;
+
+protected:
+    // Laço sobre qualquer rota e gerador (ver SA::executarCom)
+    template <class RotaT, class Gerador>
+    std::vector<int> executarCom(const Gerador& gerar);
+
+public:
+    SATrocaReplicas(const TSPInstance& instance, int numReplicas, double tempMin, double tempMax,
+                    int iteracoesPorTroca, int numTrocas, int numThreads,
+                    VizinhancaFunc vizinhanca,
+                    VizinhancaDuasCamadasFunc vizinhancaDuasCamadas = nullptr);
+
+    // Temperaturas dos degraus, da mais fria à mais quente
+    std::vector<double> getTemperaturas() const;
+
+    std::vector<int> executar() override;
+};
+
+#endif
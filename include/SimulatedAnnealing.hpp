@@ -3,7 +3,25 @@
 
 #include "TSPInstance.hpp"
 #include "FuncoesAuxiliares.hpp"
+#include "Rng.hpp"
+#include "PropostasEmLote.hpp"
+#include "Rastro.hpp"
+#include "Contadores.hpp"
+#include "Cronograma.hpp"
+#include "ControleExecucao.hpp"
+#include "Construcao.hpp"
+#include "BuscaLocal.hpp"
+#include "PontoControle.hpp"
+#include "DiarioMovimentos.hpp"
+#include "RotaDuasCamadas.hpp"
 #include <vector>
+#include <limits>
+#include <functional>
+#include <memory>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <stdexcept>
 
 class SimulatedAnnealing {
 protected:
@@ -12,7 +30,166 @@ protected:
     double taxaResfriamento;
     int iteracoesPorTemperatura;
 
+    // A partir desta dimensão a rota em dois níveis substitui a rota em vetor,
+    // se houver vizinhança para ela
+    int limiarDuasCamadas = std::numeric_limits<int>::max();
+
+    // Dados por nível: acumulados em graph_data ou, com setRastro, enviados ao destino durante
+    // a execução; ultimoNivel e niveisRegistrados valem nos dois casos
     std::vector<GraphData> graph_data;
+    std::shared_ptr<SinkRastro> rastro;
+    GraphData ultimoNivel{};
+    long long niveisRegistrados = 0;
+
+    // Propostas avaliadas na execução (todas as réplicas, na troca de réplicas)
+    long long movimentosPropostos = 0;
+
+    // Contadores do nível corrente e totais da execução (ver Contadores.hpp)
+    ContadoresNivel contadores;
+    ResumoContadores resumo;
+
+    void iniciarRegistro() {
+        graph_data.clear();
+        ultimoNivel = GraphData{};
+        niveisRegistrados = 0;
+        movimentosPropostos = 0;
+        resumo = ResumoContadores();
+        resumoBuscaLocal = ResumoBuscaLocal();
+    }
+    void registrarNivel(const GraphData& dados) {
+        ultimoNivel = dados;
+        ++niveisRegistrados;
+        resumo.acumular(dados);
+        if (rastro) rastro->registrar(dados);
+        else graph_data.push_back(dados);
+    }
+
+    // Gerador próprio do solver: rota inicial, vizinhanças e critério de aceitação
+    Rng rng;
+
+    // Mensagens de progresso em std::cout; desligado nas execuções em paralelo
+    bool verbose = false;
+
+    // Rota inicial dada pelo chamador; vazia = permutação aleatória
+    std::vector<int> rotaFixada;
+
+    // Avaliação especulativa (só SA): trabalhadores, propostas por trabalhador em cada lote e
+    // taxa de aceitação do nível anterior abaixo da qual o nível é especulativo
+    int trabalhadoresEspeculacao = 1;
+    int loteEspeculacao = 16;
+    double limiarEspeculacao = 0.05;
+
+    // Propostas em lote (só SA, Swap/Insertion/2-opt): modo, movimento e tamanho do lote
+    ModoPropostas modoPropostas = ModoPropostas::Sequencial;
+    TipoMovimento tipoPropostas = TipoMovimento::Nenhum;
+    int tamLotePropostas = 8;
+
+    // Cronograma de temperatura (só SA; ver Cronograma.hpp)
+    TipoCronograma cronograma = TipoCronograma::Geometrico;
+    CronogramaAdaptativo cronogramaAdaptativo;
+
+    // Orçamento, custo alvo e progresso (ver ControleExecucao.hpp); cancelamento é escrito por
+    // cancelar(), de qualquer thread
+    ControleExecucao controle;
+    std::atomic<bool> cancelamento{false};
+    std::chrono::steady_clock::time_point inicioExecucao;
+    MotivoParada motivoParada = MotivoParada::Cronograma;
+
+    void iniciarControle() {
+        inicioExecucao = std::chrono::steady_clock::now();
+        motivoParada = MotivoParada::Cronograma;
+        ultimoPontoControle = 0.0;
+    }
+    double segundosDecorridos() const {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - inicioExecucao).count();
+    }
+    // Confere cancelamento, orçamento e custo alvo; true = parar, com o motivo em motivoParada
+    bool interromper(long long iteracoes, double melhorCusto);
+    // Taxa de resfriamento que leva de temperatura a temperaturaFinal nos níveis que cabem na
+    // fração do orçamento restante (o tempo estimado pelo tempo médio por proposta até aqui);
+    // nunca mais lenta que taxa
+    double taxaParaOrcamento(double temperatura, double temperaturaFinal, long long iteracoes, int iterNivel,
+                             double taxa, double fracao = 1.0) const;
+    void informarProgresso(const std::vector<int>& melhorRota, double melhorCusto) const {
+        if (controle.progressoCusto) controle.progressoCusto(melhorCusto, ultimoNivel);
+        if (controle.progresso) controle.progresso(melhorRota, melhorCusto, ultimoNivel);
+    }
+    // A melhor rota do diário só é montada se houver progresso que a receba
+    template <class RotaT>
+    void informarProgresso(DiarioMovimentos<RotaT>& diario, double melhorCusto) const {
+        if (controle.progressoCusto) controle.progressoCusto(melhorCusto, ultimoNivel);
+        if (controle.progresso) controle.progresso(diario.melhor().paraVetor(), melhorCusto, ultimoNivel);
+    }
+
+    // Heurística da rota inicial quando não há rota fixada (ver Construcao.hpp)
+    TipoRotaInicial construcaoInicial = TipoRotaInicial::Aleatoria;
+    const ListaCandidatos* candidatosConstrucao = nullptr;
+
+    // Rota fixada, construída ou aleatória; a troca de réplicas passa o gerador de cada réplica.
+    // Na retomada, a melhor rota do ponto de controle só define o tamanho: executarCom restaura
+    // a rota atual
+    std::vector<int> obterRotaInicial(Rng& gerador);
+    std::vector<int> obterRotaInicial() { return retomada ? retomada->melhorRota : obterRotaInicial(rng); }
+
+    // Pontos de controle (só SA e SAReaquecimento; ver PontoControle.hpp): o estado é montado ao
+    // fim de um nível, a cada intervaloPontoControle segundos, e gravado em segundo plano
+    std::unique_ptr<GravadorPontoControle> pontoControle;
+    std::string configuracaoPontoControle;   // ver EstadoExecucao::configuracao
+    double intervaloPontoControle = 0.0;
+    double ultimoPontoControle = 0.0;
+    std::unique_ptr<EstadoExecucao> retomada;
+
+    bool pontoControleDevido() {
+        if (!pontoControle || segundosDecorridos() - ultimoPontoControle < intervaloPontoControle) return false;
+        ultimoPontoControle = segundosDecorridos();
+        return true;
+    }
+    // Campos comuns aos dois algoritmos: gerador, contadores, rastro e tempo decorrido
+    void preencherEstado(EstadoExecucao& estado, const char* algoritmo) const;
+    // Restaura os campos comuns de retomada, depois de iniciarControle e iniciarRegistro; recusa
+    // o estado de outra instância, algoritmo ou configuração
+    void restaurarEstado(const EstadoExecucao& estado, const char* algoritmo);
+    // Ao fim da execução, se não foi cancelada, apaga o ponto de controle (ver GravadorPontoControle)
+    void concluirPontoControle();
+
+    // Completa o estado com as rotas e o entrega ao gravador; as cópias ficam na thread do solver,
+    // mas só ao fim de um nível e a cada intervalo
+    template <class RotaT>
+    void enviarPontoControle(EstadoExecucao estado, const RotaT& rotaAtual, DiarioMovimentos<RotaT>& diario) {
+        estado.duasCamadas = std::is_same_v<RotaT, RotaDuasCamadas>;
+        estado.rotaAtual = rotaAtual.salvarEstado();
+        estado.melhorRota = diario.melhor().paraVetor();
+        pontoControle->enviar(std::move(estado), rastro);
+    }
+    template <class RotaT>
+    void restaurarRotas(const EstadoExecucao& estado, RotaT& rotaAtual, DiarioMovimentos<RotaT>& diario) {
+        if (estado.duasCamadas != std::is_same_v<RotaT, RotaDuasCamadas>)
+            throw std::runtime_error("Ponto de controle com outro tipo de rota");
+        rotaAtual.restaurarEstado(estado.rotaAtual);
+        diario = DiarioMovimentos<RotaT>(RotaT(estado.melhorRota));
+        diario.desviar();
+    }
+
+    // Busca local sobre as melhores rotas (ver BuscaLocal.hpp), criada no primeiro uso
+    bool buscaLocalAtiva = false;
+    const ListaCandidatos* candidatosBuscaLocal = nullptr;
+    std::unique_ptr<BuscaLocal> buscaLocal;
+    ResumoBuscaLocal resumoBuscaLocal;
+
+    // Aplica a busca local à rota, se ativa e a execução não foi cancelada nem parou por orçamento,
+    // somando ao resumo; com limite de tempo, a busca para no limite
+    void polir(std::vector<int>& rota, double& custo);
+
+public:
+    // Ponto de migração do modelo de ilhas (ver Ilhas.hpp): recebe a melhor rota da cadeia
+    // e, se houver uma rota vinda de outra ilha, a devolve em recebida/custoRecebido
+    using MigracaoFunc = std::function<bool(const std::vector<int>& melhorRota, double melhorCusto,
+                                            std::vector<int>& recebida, double& custoRecebido)>;
+
+protected:
+    // Chamada pelo laço do SA a cada intervaloMigracao níveis de temperatura
+    MigracaoFunc migracao;
+    int intervaloMigracao = 0;
 
 public:
     SimulatedAnnealing(const TSPInstance& instance, double tempInicial,
@@ -21,6 +198,54 @@ public:
     virtual std::vector<int> executar() = 0; 
     
     const std::vector<GraphData>& getGraphData() const { return graph_data; }
+    const GraphData& getUltimoNivel() const { return ultimoNivel; }
+    long long getMovimentosPropostos() const { return movimentosPropostos; }
+    const ResumoContadores& getResumoContadores() const { return resumo; }
+    const ResumoBuscaLocal& getResumoBuscaLocal() const { return resumoBuscaLocal; }
+    void setRastro(std::shared_ptr<SinkRastro> destino) { rastro = std::move(destino); }
+    void setLimiarDuasCamadas(int limiar) { limiarDuasCamadas = limiar; }
+    void setSemente(uint64_t semente) { rng.semear(semente); }
+    void setVerbose(bool ativo) { verbose = ativo; }
+    void setMigracao(int intervalo, MigracaoFunc func) { intervaloMigracao = intervalo; migracao = std::move(func); }
+    void setRotaInicial(std::vector<int> rota) { rotaFixada = std::move(rota); }
+    void setConstrucaoInicial(TipoRotaInicial tipo, const ListaCandidatos* candidatos = nullptr) {
+        construcaoInicial = tipo;
+        candidatosConstrucao = candidatos;
+    }
+    void setBuscaLocal(bool ativa, const ListaCandidatos* candidatos = nullptr) {
+        buscaLocalAtiva = ativa;
+        candidatosBuscaLocal = candidatos;
+        buscaLocal.reset();
+    }
+    void setTemperaturaInicial(double temperatura) { temperaturaInicial = temperatura; }
+    void setEspeculacao(int trabalhadores, int lotePorTrabalhador, double limiarAceitacao) {
+        trabalhadoresEspeculacao = trabalhadores;
+        loteEspeculacao = lotePorTrabalhador;
+        limiarEspeculacao = limiarAceitacao;
+    }
+    void setPropostasEmLote(ModoPropostas modo, TipoMovimento tipo, int tamanho) {
+        modoPropostas = modo;
+        tipoPropostas = tipo;
+        tamLotePropostas = tamanho;
+    }
+    void setCronograma(TipoCronograma tipo, const CronogramaAdaptativo& adaptativo = CronogramaAdaptativo()) {
+        cronograma = tipo;
+        cronogramaAdaptativo = adaptativo;
+    }
+    void setControle(ControleExecucao c) { controle = std::move(c); }
+    // Troca só o progresso por custo, mantendo orçamento e alvo
+    void setProgressoCusto(ControleExecucao::ProgressoCustoFunc progresso) { controle.progressoCusto = std::move(progresso); }
+    void setPontoControle(const std::string& caminho, double intervaloSegundos, std::string configuracao = "") {
+        pontoControle = std::make_unique<GravadorPontoControle>(caminho);
+        intervaloPontoControle = intervaloSegundos;
+        configuracaoPontoControle = std::move(configuracao);
+    }
+    // A próxima execução continua do estado em vez de começar do zero
+    void setRetomada(EstadoExecucao estado) { retomada = std::make_unique<EstadoExecucao>(std::move(estado)); }
+
+    // Pede a parada da execução em andamento (ou da próxima); seguro de qualquer thread
+    void cancelar() { cancelamento.store(true, std::memory_order_relaxed); }
+    MotivoParada getMotivoParada() const { return motivoParada; }
 
     virtual ~SimulatedAnnealing();
 };
@@ -2,7 +2,6 @@
 #define TSP_INSTANCE_HPP
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <vector>
 #include <string>
 #include <cmath>
@@ -10,6 +9,20 @@
 #include <stdexcept>
 #include <algorithm>
 #include <numeric>
+#include <cstdint>
+#include <cstring>
+#include <charconv>
+#include <thread>
+#include <map>
+#include <memory>
+#include <filesystem>
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define TSP_INSTANCE_MMAP 1
+#endif
 
 class TSPInstance {
 public:
@@ -23,6 +36,8 @@ public:
     enum class ProblemType { TSP, ATSP, HCP, SOP, CVRP, UNKNOWN };
     enum class EdgeWeightType { EXPLICIT, EUC_2D, EUC_3D, MAX_2D, MAX_3D, MAN_2D, MAN_3D, CEIL_2D, GEO, ATT, XRAY1, XRAY2, SPECIAL, UNKNOWN };
     enum class EdgeWeightFormat { FUNCTION, FULL_MATRIX, UPPER_ROW, LOWER_ROW, UPPER_DIAG_ROW, LOWER_DIAG_ROW, UPPER_COL, LOWER_COL, UPPER_DIAG_COL, LOWER_DIAG_COL, UNKNOWN };
+    // Caches das distâncias de computeDistance (arredondadas como no TSPLIB), em int32 ou float
+    enum class DistanceMatrixType { NONE, INT32, FLOAT32 };
 
 private:
     ProblemType type;
@@ -32,12 +47,23 @@ private:
     EdgeWeightType edge_weight_type;
     EdgeWeightFormat edge_weight_format;
     std::vector<City> cities;
-    std::vector<std::vector<int>> edge_weights;
+    // Pesos EXPLICIT num único buffer contíguo: matriz n x n para FULL_MATRIX,
+    // ou triângulo inferior com diagonal empacotado (n(n+1)/2) para os formatos simétricos
+    std::vector<int> edge_weights;
+    bool edge_weights_packed = false;
     std::vector<std::vector<int>> fixed_edges;
     int capacity;
     std::vector<int> demands;
     std::vector<int> depots;
 
+    // Cache opcional da matriz de distâncias, contígua e em ordem de linhas (dimension x dimension).
+    // Os dados ficam num vetor próprio ou direto no .tspbin mapeado; matrix_owner mantém vivo
+    // um ou outro, e as cópias da instância compartilham a mesma matriz (só leitura)
+    DistanceMatrixType matrix_type = DistanceMatrixType::NONE;
+    std::shared_ptr<const void> matrix_owner;
+    const int32_t* matrix_i32 = nullptr;
+    const float* matrix_f32 = nullptr;
+
     std::unordered_map<std::string, ProblemType> problemTypeMap = {
         {"TSP", ProblemType::TSP}, {"ATSP", ProblemType::ATSP},
         {"HCP", ProblemType::HCP}, {"SOP", ProblemType::SOP},
@@ -67,17 +93,19 @@ private:
         {"LOWER_DIAG_COL", EdgeWeightFormat::LOWER_DIAG_COL}
     };
 
-    double euclideanDistance2D(const City& a, const City& b) const {
+public:
+    // Métricas do TSPLIB sobre duas cidades, sem arredondamento (ver roundedDistance)
+    static double euclideanDistance2D(const City& a, const City& b) {
         double dx = a.x - b.x;
         double dy = a.y - b.y;
         return std::sqrt(dx*dx + dy*dy);
     }
 
-    double manhattanDistance2D(const City& a, const City& b) const {
+    static double manhattanDistance2D(const City& a, const City& b) {
         return std::abs(a.x - b.x) + std::abs(a.y - b.y);
     }
 
-    double geographicalDistance(const City& a, const City& b) const {
+    static double geographicalDistance(const City& a, const City& b) {
         const double PI = 3.141592;
         const double RRR = 6378.388;
 
@@ -99,7 +127,7 @@ private:
         return RRR * std::acos(0.5 * ((1.0 + q1) * q2 - (1.0 - q1) * q3)) + 1.0;
     }
 
-    double attDistance(const City& a, const City& b) const {
+    static double attDistance(const City& a, const City& b) {
         double dx = a.x - b.x;
         double dy = a.y - b.y;
         double rij = std::sqrt((dx*dx + dy*dy) / 10.0);
@@ -107,186 +135,661 @@ private:
         return tij < rij ? tij + 1 : tij;
     }
 
-    void expandMatrix() {
-        if (edge_weights.empty() || edge_weights[0].empty()) return;
+    // nint do TSPLIB, aplicado às métricas acima (GEO é truncada)
+    static double nint(double d) { return static_cast<double>(std::lround(d)); }
 
-        std::vector<std::vector<int>> full_matrix(dimension, std::vector<int>(dimension, 0));
-        const auto& weights = edge_weights[0];
-        size_t index = 0;
+private:
 
-        switch (edge_weight_format) {
-            case EdgeWeightFormat::LOWER_ROW:
-                for (int i = 1; i < dimension; ++i) {
-                    for (int j = 0; j < i; ++j) {
-                        full_matrix[i][j] = weights[index++];
-                        full_matrix[j][i] = full_matrix[i][j];
-                    }
-                }
-                break;
-                
+    // Distância antes do arredondamento do TSPLIB
+    double rawDistance(int i, int j) const {
+        if (i == j) return 0.0;
+
+        if (edge_weight_type == EdgeWeightType::EXPLICIT) {
+            return edge_weights[weightIndex(i, j)];
+        }
+
+        const City& a = cities[i];
+        const City& b = cities[j];
+
+        switch (edge_weight_type) {
+            case EdgeWeightType::EUC_2D: return euclideanDistance2D(a, b);
+            case EdgeWeightType::MAN_2D: return manhattanDistance2D(a, b);
+            case EdgeWeightType::GEO: return geographicalDistance(a, b);
+            case EdgeWeightType::ATT: return attDistance(a, b);
+            default: throw std::runtime_error("Tipo de distância não implementado");
+        }
+    }
+
+    // Distância da instância, conforme a especificação do TSPLIB; a matriz INT32 só a guarda
+    double computeDistance(int i, int j) const {
+        if (edge_weight_type == EdgeWeightType::EXPLICIT) return rawDistance(i, j);
+        return roundedDistance(i, j);
+    }
+
+    int32_t roundedDistance(int i, int j) const {
+        double d = rawDistance(i, j);
+        switch (edge_weight_type) {
+            case EdgeWeightType::GEO: return static_cast<int32_t>(d);
+            default: return static_cast<int32_t>(std::lround(d));
+        }
+    }
+
+    size_t weightIndex(int i, int j) const {
+        if (!edge_weights_packed) return static_cast<size_t>(i) * dimension + j;
+        if (i < j) std::swap(i, j);
+        return static_cast<size_t>(i) * (i + 1) / 2 + j;
+    }
+
+    // Cursor sobre a ordem em que cada EdgeWeightFormat lista os pesos. Os formatos *_COL
+    // de um triângulo percorrem os mesmos pares que o *_ROW do triângulo oposto, e como a
+    // matriz é simétrica basta reaproveitar o mesmo percurso.
+    struct WeightCursor {
+        enum class Shape { FULL, UPPER, LOWER, UPPER_DIAG, LOWER_DIAG } shape = Shape::FULL;
+        int row = 0;
+        int col = 0;
+        int n = 0;
+
+        int firstCol(int r) const {
+            switch (shape) {
+                case Shape::UPPER: return r + 1;
+                case Shape::UPPER_DIAG: return r;
+                default: return 0;
+            }
+        }
+
+        int lastCol(int r) const {
+            switch (shape) {
+                case Shape::LOWER: return r - 1;
+                case Shape::LOWER_DIAG: return r;
+                default: return n - 1;
+            }
+        }
+
+        void start(Shape s, int dim) {
+            shape = s;
+            n = dim;
+            row = (shape == Shape::LOWER) ? 1 : 0;
+            col = firstCol(row);
+        }
+
+        bool done() const { return row >= n || (shape == Shape::UPPER && row >= n - 1); }
+
+        void advance() {
+            if (++col > lastCol(row)) {
+                ++row;
+                col = firstCol(row);
+            }
+        }
+
+        size_t rowLength(int r) const { return static_cast<size_t>(lastCol(r) - firstCol(r) + 1); }
+
+        // Número total de pesos que o formato lista
+        size_t count() const {
+            WeightCursor c = *this;
+            c.start(shape, n);
+            size_t total = 0;
+            for (; !c.done(); ++c.row) total += c.rowLength(c.row);
+            return total;
+        }
+
+        // Posiciona o cursor no k-ésimo peso a partir do início
+        void seek(size_t k) {
+            start(shape, n);
+            while (!done() && k >= rowLength(row)) k -= rowLength(row++);
+            col = firstCol(row) + static_cast<int>(k);
+        }
+    };
+
+    static WeightCursor::Shape shapeOf(EdgeWeightFormat format) {
+        using Shape = WeightCursor::Shape;
+        switch (format) {
             case EdgeWeightFormat::UPPER_ROW:
-                for (int i = 0; i < dimension; ++i) {
-                    for (int j = i + 1; j < dimension; ++j) {
-                        full_matrix[i][j] = weights[index++];
-                        full_matrix[j][i] = full_matrix[i][j];
-                    }
-                }
-                break;
-                
-            case EdgeWeightFormat::LOWER_DIAG_ROW:
-                for (int i = 0; i < dimension; ++i) {
-                    for (int j = 0; j <= i; ++j) {
-                        full_matrix[i][j] = weights[index++];
-                        full_matrix[j][i] = full_matrix[i][j];
-                    }
-                }
-                break;
-                
+            case EdgeWeightFormat::LOWER_COL: return Shape::UPPER;
+            case EdgeWeightFormat::LOWER_ROW:
+            case EdgeWeightFormat::UPPER_COL: return Shape::LOWER;
             case EdgeWeightFormat::UPPER_DIAG_ROW:
-                for (int i = 0; i < dimension; ++i) {
-                    for (int j = i; j < dimension; ++j) {
-                        full_matrix[i][j] = weights[index++];
-                        full_matrix[j][i] = full_matrix[i][j];
-                    }
+            case EdgeWeightFormat::LOWER_DIAG_COL: return Shape::UPPER_DIAG;
+            case EdgeWeightFormat::LOWER_DIAG_ROW:
+            case EdgeWeightFormat::UPPER_DIAG_COL: return Shape::LOWER_DIAG;
+            default: return Shape::FULL;
+        }
+    }
+
+    void beginEdgeWeights(WeightCursor& cursor) {
+        if (dimension <= 0) {
+            throw std::runtime_error("EDGE_WEIGHT_SECTION antes de DIMENSION");
+        }
+        const size_t n = static_cast<size_t>(dimension);
+        cursor.start(shapeOf(edge_weight_format), dimension);
+        edge_weights_packed = (cursor.shape != WeightCursor::Shape::FULL);
+        edge_weights.assign(edge_weights_packed ? n * (n + 1) / 2 : n * n, 0);
+    }
+
+    // Conteúdo do arquivo: mapeado em memória quando o sistema permite, senão lido num buffer
+    class MappedFile {
+    private:
+        const char* data = nullptr;
+        size_t size = 0;
+        bool mapped = false;
+        std::string buffer;
+
+    public:
+        explicit MappedFile(const std::string& filename) {
+#ifdef TSP_INSTANCE_MMAP
+            int fd = ::open(filename.c_str(), O_RDONLY);
+            if (fd < 0) throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
+            struct stat st{};
+            if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+                void* m = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+                if (m != MAP_FAILED) {
+                    data = static_cast<const char*>(m);
+                    size = st.st_size;
+                    mapped = true;
+                    ::madvise(m, size, MADV_SEQUENTIAL);
                 }
-                break;
-                
-            default:
-                return;
+            }
+            ::close(fd);
+            if (mapped || st.st_size == 0) return;
+#endif
+            std::ifstream file(filename, std::ios::binary);
+            if (!file.is_open()) throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
+            buffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            data = buffer.data();
+            size = buffer.size();
+        }
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        ~MappedFile() {
+#ifdef TSP_INSTANCE_MMAP
+            if (mapped) ::munmap(const_cast<char*>(data), size);
+#endif
         }
 
-        edge_weights = full_matrix;
-        edge_weight_format = EdgeWeightFormat::FULL_MATRIX;
+        const char* begin() const { return data; }
+        const char* end() const { return data + size; }
+    };
+
+    // ===== Cache binário (.tspbin) =====
+    // Cabeçalho, tabela de seções e seções alinhadas a 64 bytes. O arquivo é validado pelo
+    // hash e pelo tamanho do .tsp de origem; as seções são copiadas do mapeamento sem parsing.
+    static constexpr char binaryMagic[8] = {'T', 'S', 'P', 'B', 'I', 'N', 0, 0};
+    static constexpr uint32_t binaryVersion = 4;
+    enum BinaryTag : uint32_t { TAG_CITIES = 1, TAG_EDGE_WEIGHTS, TAG_MATRIX_I32, TAG_MATRIX_F32, TAG_NEIGHBOURS };
+
+    struct BinaryHeader {
+        char magic[8];
+        uint32_t version;
+        uint32_t city_size;
+        uint64_t source_hash;
+        uint64_t source_size;
+        int32_t type;
+        int32_t dimension;
+        int32_t edge_weight_type;
+        int32_t edge_weight_format;
+        int32_t edge_weights_packed;
+        uint32_t name_length;     // NAME e COMMENT seguem o cabeçalho, sem terminador
+        uint32_t section_count;
+        uint32_t comment_length;
+    };
+
+    static size_t headerLength(const BinaryHeader& header) {
+        return sizeof header + header.name_length + header.comment_length;
     }
 
-public:
-    TSPInstance() : type(ProblemType::UNKNOWN), dimension(0), 
-                   edge_weight_type(EdgeWeightType::UNKNOWN),
-                   edge_weight_format(EdgeWeightFormat::UNKNOWN), capacity(0) {}
+    // param: k das listas de vizinhos; matrix: tipo de matriz com que foram ordenadas
+    struct BinarySection {
+        uint32_t tag;
+        int32_t param;
+        int32_t matrix;
+        uint32_t reserved;
+        uint64_t offset;
+        uint64_t bytes;
+    };
 
-    void loadFromFile(const std::string& filename) {
-        std::ifstream file(filename);
-        if (!file.is_open()) {
-            throw std::runtime_error("Não foi possível abrir o arquivo: " + filename);
-        }
-
-        std::string line;
-        bool in_spec_section = true;
-        bool in_node_coord_section = false;
-        bool in_edge_weight_section = false;
-        bool in_fixed_edges_section = false;
-        bool in_depot_section = false;
-        bool in_demand_section = false;
-
-        while (std::getline(file, line)) {
-            // Processar linha
-            line.erase(std::find_if(line.rbegin(), line.rend(), [](int ch) {
-                return !std::isspace(ch);
-            }).base(), line.end());
-
-            if (line.empty()) continue;
-
-            std::string upper_line = line;
-            std::transform(upper_line.begin(), upper_line.end(), upper_line.begin(), ::toupper);
-
-            if (in_spec_section) {
-                if (upper_line.find("NODE_COORD_SECTION") != std::string::npos) {
-                    in_spec_section = false;
-                    if (edge_weight_type != EdgeWeightType::EXPLICIT) {
-                        in_node_coord_section = true;
-                    }
-                    continue;
-                } else if (upper_line.find("EDGE_WEIGHT_SECTION") != std::string::npos) {
-                    in_spec_section = false;
-                    in_edge_weight_section = true;
-                    edge_weights.push_back({});
-                    continue;
-                } else if (upper_line.find("EOF") != std::string::npos) {
-                    break;
-                }
+    bool cache_enabled = false;
+    std::string cache_directory;
+    std::string cache_path;
+    uint64_t source_hash = 0;
+    uint64_t source_size = 0;
+    bool cache_loaded = false;
+    bool cache_dirty = false;
+    std::shared_ptr<const MappedFile> cache_file;
+    // Listas de k vizinhos por (k, tipo de matriz), para ListaCandidatos
+    std::map<std::pair<int, int>, std::vector<int>> neighbour_lists;
+
+    // FNV-1a de 64 bits
+    static uint64_t hashBytes(const char* p, const char* end) {
+        uint64_t h = 1469598103934665603ull;
+        for (; p < end; ++p) h = (h ^ static_cast<unsigned char>(*p)) * 1099511628211ull;
+        return h;
+    }
 
-                size_t colon_pos = line.find(':');
-                if (colon_pos == std::string::npos) continue;
+    // Sufixo do arquivo temporário, distinto entre processos e threads
+    static uint64_t uniqueSuffix() {
+        uint64_t suffix = std::hash<std::thread::id>()(std::this_thread::get_id());
+#ifdef TSP_INSTANCE_MMAP
+        suffix = suffix * 31 + static_cast<uint64_t>(::getpid());
+#endif
+        return suffix;
+    }
 
-                std::string keyword = line.substr(0, colon_pos);
-                std::string value = line.substr(colon_pos + 1);
-                
-                keyword.erase(std::remove_if(keyword.begin(), keyword.end(), ::isspace), keyword.end());
-                value.erase(std::remove_if(value.begin(), value.end(), ::isspace), value.end());
+    std::string binaryCachePath(const std::string& filename) const {
+        std::filesystem::path source(filename);
+        if (cache_directory.empty()) return source.replace_extension(".tspbin").string();
+        return (std::filesystem::path(cache_directory) / source.stem()).string() + ".tspbin";
+    }
 
-                if (keyword == "NAME") name = value;
-                else if (keyword == "TYPE") {
-                    auto it = problemTypeMap.find(value);
-                    if (it != problemTypeMap.end()) type = it->second;
-                }
-                else if (keyword == "DIMENSION") dimension = std::stoi(value);
-                else if (keyword == "EDGE_WEIGHT_TYPE") {
-                    auto it = edgeWeightTypeMap.find(value);
-                    if (it != edgeWeightTypeMap.end()) edge_weight_type = it->second;
-                }
-                else if (keyword == "EDGE_WEIGHT_FORMAT") {
-                    auto it = edgeWeightFormatMap.find(value);
-                    if (it != edgeWeightFormatMap.end()) edge_weight_format = it->second;
-                }
-            } 
-            else if (in_node_coord_section) {
-                std::istringstream iss(line);
-                City city;
-                iss >> city.id >> city.x >> city.y;
-                city.z = 0.0;
-                cities.push_back(city);
-                
-                if (cities.size() == static_cast<size_t>(dimension)) {
-                    in_node_coord_section = false;
-                }
-            } 
-            else if (in_edge_weight_section) {
-                std::istringstream iss(line);
+    // Seção do cache carregado, ou nullptr
+    const char* findCachedSection(uint32_t tag, int32_t param, int32_t matrix, uint64_t& bytes) const {
+        if (!cache_file) return nullptr;
+        const char* base = cache_file->begin();
+        BinaryHeader header;
+        std::memcpy(&header, base, sizeof header);
+        const char* table = base + headerLength(header);
+        for (uint32_t s = 0; s < header.section_count; ++s) {
+            BinarySection section;
+            std::memcpy(&section, table + s * sizeof section, sizeof section);
+            if (section.tag == tag && section.param == param && section.matrix == matrix) {
+                bytes = section.bytes;
+                return base + section.offset;
+            }
+        }
+        return nullptr;
+    }
+
+    template <class T>
+    bool copyCachedSection(uint32_t tag, int32_t param, int32_t matrix, std::vector<T>& out, size_t count) const {
+        uint64_t bytes;
+        const char* data = findCachedSection(tag, param, matrix, bytes);
+        if (!data || bytes != count * sizeof(T)) return false;
+        out.resize(count);
+        std::memcpy(out.data(), data, bytes);
+        return true;
+    }
+
+    // Carrega o .tspbin se existir, for desta versão e corresponder ao .tsp de origem
+    bool loadBinaryCache() {
+        std::error_code ec;
+        if (!std::filesystem::is_regular_file(cache_path, ec)) return false;
+        std::shared_ptr<MappedFile> file;
+        try {
+            file = std::make_shared<MappedFile>(cache_path);
+        } catch (const std::exception&) {
+            return false;
+        }
+
+        const size_t size = file->end() - file->begin();
+        BinaryHeader header;
+        if (size < sizeof header) return false;
+        std::memcpy(&header, file->begin(), sizeof header);
+        if (std::memcmp(header.magic, binaryMagic, sizeof binaryMagic) != 0 || header.version != binaryVersion
+            || header.city_size != sizeof(City) || header.source_hash != source_hash
+            || header.source_size != source_size || header.dimension < 0) return false;
+
+        const size_t tableEnd = headerLength(header) + header.section_count * sizeof(BinarySection);
+        if (tableEnd > size) return false;
+        for (uint32_t s = 0; s < header.section_count; ++s) {
+            BinarySection section;
+            std::memcpy(&section, file->begin() + headerLength(header) + s * sizeof section, sizeof section);
+            if (section.offset < tableEnd || section.offset > size || section.bytes > size - section.offset) return false;
+        }
+
+        cache_file = file;
+        const size_t n = header.dimension;
+        std::vector<City> cachedCities;
+        if (!copyCachedSection(TAG_CITIES, 0, 0, cachedCities, n)) {
+            cache_file.reset();
+            return false;
+        }
+        uint64_t weightBytes = 0;
+        if (findCachedSection(TAG_EDGE_WEIGHTS, 0, 0, weightBytes)
+            && !copyCachedSection(TAG_EDGE_WEIGHTS, 0, 0, edge_weights, weightBytes / sizeof(int))) {
+            cache_file.reset();
+            return false;
+        }
+
+        name.assign(file->begin() + sizeof header, header.name_length);
+        comment.assign(file->begin() + sizeof header + header.name_length, header.comment_length);
+        type = static_cast<ProblemType>(header.type);
+        dimension = header.dimension;
+        edge_weight_type = static_cast<EdgeWeightType>(header.edge_weight_type);
+        edge_weight_format = static_cast<EdgeWeightFormat>(header.edge_weight_format);
+        edge_weights_packed = header.edge_weights_packed != 0;
+        cities = std::move(cachedCities);
+
+        const char* table = file->begin() + headerLength(header);
+        for (uint32_t s = 0; s < header.section_count; ++s) {
+            BinarySection section;
+            std::memcpy(&section, table + s * sizeof section, sizeof section);
+            if (section.tag != TAG_NEIGHBOURS || section.param <= 0) continue;
+            copyCachedSection(TAG_NEIGHBOURS, section.param, section.matrix,
+                              neighbour_lists[{section.param, section.matrix}], n * section.param);
+        }
+        return true;
+    }
+
+
+    // Espaço no sentido de std::isspace no locale "C"
+    static bool isSpace(char c) { return c == ' ' || (c >= '\t' && c <= '\r'); }
+
+    // Próxima linha não vazia em [lb, le), sem os espaços finais
+    static bool nextLine(const char*& p, const char* end, const char*& lb, const char*& le) {
+        while (p < end) {
+            lb = p;
+            const char* nl = static_cast<const char*>(std::memchr(p, '\n', end - p));
+            le = nl ? nl : end;
+            p = nl ? nl + 1 : end;
+            while (le > lb && isSpace(le[-1])) --le;
+            if (le > lb) return true;
+        }
+        return false;
+    }
+
+    // key (em maiúsculas) aparece em [lb, le) sem diferenciar maiúsculas
+    static bool containsUpper(const char* lb, const char* le, const char* key) {
+        size_t k = std::strlen(key);
+        for (const char* c = lb; c + k <= le; ++c) {
+            size_t t = 0;
+            while (t < k && std::toupper(static_cast<unsigned char>(c[t])) == key[t]) ++t;
+            if (t == k) return true;
+        }
+        return false;
+    }
+
+    // Próximo número de [p, le) como operator>>: pula espaços e aceita sinal '+'
+    template <class T>
+    static bool parseNumber(const char*& p, const char* le, T& value) {
+        while (p < le && isSpace(*p)) ++p;
+        const char* first = p;
+        if (first < le && *first == '+' && first + 1 < le && first[1] != '-') ++first;
+        auto [ptr, ec] = std::from_chars(first, le, value);
+        if (ec != std::errc()) return false;
+        p = ptr;
+        return true;
+    }
+
+    // PALAVRA : valor, sem nenhum espaço em nenhum dos lados (COMMENT só sem os das pontas)
+    void parseSpecLine(const char* lb, const char* le) {
+        const char* colon = static_cast<const char*>(std::memchr(lb, ':', le - lb));
+        if (!colon) return;
+        std::string keyword, value;
+        for (const char* c = lb; c < colon; ++c) if (!isSpace(*c)) keyword += *c;
+        for (const char* c = colon + 1; c < le; ++c) if (!isSpace(*c)) value += *c;
+
+        if (keyword == "NAME") name = value;
+        else if (keyword == "COMMENT") {
+            // O comentário mantém os espaços internos; várias linhas COMMENT são unidas
+            const char* b = colon + 1;
+            const char* e = le;
+            while (b < e && isSpace(*b)) ++b;
+            while (e > b && isSpace(e[-1])) --e;
+            if (!comment.empty()) comment += '\n';
+            comment.append(b, e);
+        }
+        else if (keyword == "TYPE") {
+            auto it = problemTypeMap.find(value);
+            if (it != problemTypeMap.end()) type = it->second;
+        }
+        else if (keyword == "DIMENSION") dimension = std::stoi(value);
+        else if (keyword == "EDGE_WEIGHT_TYPE") {
+            auto it = edgeWeightTypeMap.find(value);
+            if (it != edgeWeightTypeMap.end()) edge_weight_type = it->second;
+        }
+        else if (keyword == "EDGE_WEIGHT_FORMAT") {
+            auto it = edgeWeightFormatMap.find(value);
+            if (it != edgeWeightFormatMap.end()) edge_weight_format = it->second;
+        }
+    }
+
+    // Seções de pesos a partir deste tamanho são divididas entre threads
+    static constexpr std::ptrdiff_t parallelWeightBytes = 1 << 20;
+
+    // Lê os pesos como uma sequência de inteiros separados por espaços, em blocos paralelos:
+    // cada thread conta os números do seu bloco, a soma prefixada dá a posição do primeiro
+    // no cursor, e cada uma preenche a sua parte. Só vale se todos os números até o último
+    // peso forem inteiros bem formados (igual à leitura por linha); senão retorna false.
+    bool parseEdgeWeightsParallel(const char* begin, const char* end, const WeightCursor& cursor) {
+        const size_t total = cursor.count();
+        const std::ptrdiff_t bytes = end - begin;
+        int numThreads = static_cast<int>(std::min<std::ptrdiff_t>(
+            std::max(1u, std::thread::hardware_concurrency()), bytes / (parallelWeightBytes / 4) + 1));
+
+        // Limites dos blocos, avançados até um espaço para não partir números
+        std::vector<const char*> limits(numThreads + 1, end);
+        limits[0] = begin;
+        for (int t = 1; t < numThreads; ++t) {
+            const char* c = std::max(limits[t - 1], begin + bytes * t / numThreads);
+            while (c < end && !isSpace(*c)) ++c;
+            limits[t] = c;
+        }
+
+        auto emParalelo = [numThreads](auto&& tarefa) {
+            std::vector<std::thread> threads;
+            for (int t = 1; t < numThreads; ++t) threads.emplace_back(tarefa, t);
+            tarefa(0);
+            for (std::thread& th : threads) th.join();
+        };
+
+        std::vector<size_t> firstIndex(numThreads + 1, 0);
+        emParalelo([&](int t) {
+            size_t tokens = 0;
+            for (const char* c = limits[t]; c < limits[t + 1]; ) {
+                while (c < limits[t + 1] && isSpace(*c)) ++c;
+                if (c == limits[t + 1]) break;
+                ++tokens;
+                while (c < limits[t + 1] && !isSpace(*c)) ++c;
+            }
+            firstIndex[t + 1] = tokens;
+        });
+        std::partial_sum(firstIndex.begin(), firstIndex.end(), firstIndex.begin());
+        if (firstIndex[numThreads] < total) return false;
+
+        std::vector<char> ok(numThreads, 1);
+        emParalelo([&](int t) {
+            if (firstIndex[t] >= total) return;
+            WeightCursor c = cursor;
+            c.seek(firstIndex[t]);
+            const char* p = limits[t];
+            for (size_t k = firstIndex[t]; k < total && k < firstIndex[t + 1]; ++k) {
                 int weight;
-                while (iss >> weight) {
-                    edge_weights.back().push_back(weight);
+                if (!parseNumber(p, limits[t + 1], weight) || (p < limits[t + 1] && !isSpace(*p))) {
+                    ok[t] = 0;
+                    return;
                 }
+                edge_weights[weightIndex(c.row, c.col)] = weight;
+                c.advance();
+            }
+        });
+        return std::all_of(ok.begin(), ok.end(), [](char v) { return v != 0; });
+    }
+
+    // Lê o arquivo inteiro de uma vez (mmap) e interpreta o buffer no lugar com from_chars.
+    // Mesma semântica da leitura linha a linha com getline/istringstream: linhas sem os
+    // espaços finais, palavras-chave achadas em qualquer posição da linha (sem diferenciar
+    // maiúsculas), só a primeira seção de dados é lida e o resto do arquivo é ignorado.
+    void parseBuffer(const char* p, const char* end) {
+        const char* lb;
+        const char* le;
+
+        // Especificação até a primeira seção
+        enum class Section { NONE, NODE_COORD, EDGE_WEIGHT } section = Section::NONE;
+        while (section == Section::NONE && nextLine(p, end, lb, le)) {
+            if (containsUpper(lb, le, "NODE_COORD_SECTION")) {
+                if (edge_weight_type != EdgeWeightType::EXPLICIT) section = Section::NODE_COORD;
+                else break;
+            } else if (containsUpper(lb, le, "EDGE_WEIGHT_SECTION")) {
+                section = Section::EDGE_WEIGHT;
+            } else if (containsUpper(lb, le, "EOF")) {
+                break;
+            } else {
+                parseSpecLine(lb, le);
+            }
+        }
 
-                // Verificar se completou a matriz
-                size_t expected_size = 0;
-                switch (edge_weight_format) {
-                    case EdgeWeightFormat::FULL_MATRIX:
-                        if (edge_weights.size() == static_cast<size_t>(dimension)) {
-                            in_edge_weight_section = false;
-                        }
-                        break;
-                    case EdgeWeightFormat::LOWER_ROW:
-                    case EdgeWeightFormat::UPPER_ROW:
-                        expected_size = dimension * (dimension - 1) / 2;
-                        if (edge_weights[0].size() >= expected_size) {
-                            in_edge_weight_section = false;
-                            expandMatrix();
-                        }
-                        break;
-                    case EdgeWeightFormat::LOWER_DIAG_ROW:
-                    case EdgeWeightFormat::UPPER_DIAG_ROW:
-                        expected_size = dimension * (dimension + 1) / 2;
-                        if (edge_weights[0].size() >= expected_size) {
-                            in_edge_weight_section = false;
-                            expandMatrix();
-                        }
-                        break;
-                    default:
-                        if (edge_weights[0].size() >= static_cast<size_t>(dimension * dimension)) {
-                            in_edge_weight_section = false;
-                        }
+        if (section == Section::NODE_COORD) {
+            if (dimension > 0) cities.reserve(cities.size() + dimension);
+            while (nextLine(p, end, lb, le)) {
+                City city{};
+                const char* q = lb;
+                if (parseNumber(q, le, city.id) && parseNumber(q, le, city.x)) parseNumber(q, le, city.y);
+                cities.push_back(city);
+                if (cities.size() == static_cast<size_t>(dimension)) break;
+            }
+        } else if (section == Section::EDGE_WEIGHT) {
+            WeightCursor cursor;
+            beginEdgeWeights(cursor);
+            if (end - p < parallelWeightBytes || !parseEdgeWeightsParallel(p, end, cursor)) {
+                std::fill(edge_weights.begin(), edge_weights.end(), 0);
+                cursor.start(cursor.shape, dimension);
+                while (!cursor.done() && nextLine(p, end, lb, le)) {
+                    int weight;
+                    while (!cursor.done() && parseNumber(lb, le, weight)) {
+                        edge_weights[weightIndex(cursor.row, cursor.col)] = weight;
+                        cursor.advance();
+                    }
                 }
             }
         }
 
         // Se for matriz explícita sem coordenadas, cria cidades fictícias
         if (edge_weight_type == EdgeWeightType::EXPLICIT && cities.empty()) {
+            cities.reserve(dimension);
             for (int i = 1; i <= dimension; ++i) {
                 cities.push_back({i, 0.0, 0.0, 0.0});
             }
         }
+    }
+
+public:
+    TSPInstance() : type(ProblemType::UNKNOWN), dimension(0), 
+                   edge_weight_type(EdgeWeightType::UNKNOWN),
+                   edge_weight_format(EdgeWeightFormat::UNKNOWN), capacity(0) {}
+
+    // Com o cache binário ligado, loadFromFile usa o .tspbin em directory (vazio = ao lado do
+    // .tsp) quando ele corresponde ao .tsp, e saveBinaryCache o grava ou atualiza
+    void enableBinaryCache(const std::string& directory = "") {
+        cache_enabled = true;
+        cache_directory = directory;
+    }
+
+    void loadFromFile(const std::string& filename) {
+        MappedFile file(filename);
+        if (cache_enabled) {
+            source_hash = hashBytes(file.begin(), file.end());
+            source_size = file.end() - file.begin();
+            cache_path = binaryCachePath(filename);
+            cache_loaded = loadBinaryCache();
+            cache_dirty = !cache_loaded;
+            if (cache_loaded) return;
+        }
+        parseBuffer(file.begin(), file.end());
+    }
+
+    bool loadedFromBinaryCache() const { return cache_loaded; }
+
+    // Grava o .tspbin com tudo o que a instância tem agora (matrizes e listas de vizinhos,
+    // incluindo as do cache anterior), se houver algo novo. Escreve num temporário e o
+    // renomeia, para execuções em paralelo nunca lerem um arquivo pela metade.
+    bool saveBinaryCache() {
+        if (!cache_enabled || !cache_dirty || cache_path.empty()) return false;
+
+        struct Block { BinarySection section; const void* data; };
+        std::vector<Block> blocks;
+        auto add = [&](uint32_t tag, int32_t param, int32_t matrix, const void* data, size_t bytes) {
+            blocks.push_back({{tag, param, matrix, 0, 0, bytes}, data});
+        };
+        auto addCachedOr = [&](uint32_t tag, const void* data, size_t bytes) {
+            uint64_t cachedBytes;
+            const char* cached = findCachedSection(tag, 0, 0, cachedBytes);
+            if (bytes > 0) add(tag, 0, 0, data, bytes);
+            else if (cached) add(tag, 0, 0, cached, cachedBytes);
+        };
+
+        // Cópia das cidades com o preenchimento zerado, para o arquivo ser determinístico
+        std::vector<City> cityRecords(cities.size());
+        std::memset(static_cast<void*>(cityRecords.data()), 0, cityRecords.size() * sizeof(City));
+        for (size_t c = 0; c < cities.size(); ++c) {
+            cityRecords[c].id = cities[c].id;
+            cityRecords[c].x = cities[c].x;
+            cityRecords[c].y = cities[c].y;
+            cityRecords[c].z = cities[c].z;
+        }
+        add(TAG_CITIES, 0, 0, cityRecords.data(), cityRecords.size() * sizeof(City));
+        if (!edge_weights.empty()) add(TAG_EDGE_WEIGHTS, 0, 0, edge_weights.data(), edge_weights.size() * sizeof(int));
+        const size_t cells = static_cast<size_t>(dimension) * dimension;
+        addCachedOr(TAG_MATRIX_I32, matrix_i32, matrix_i32 ? cells * sizeof(int32_t) : 0);
+        addCachedOr(TAG_MATRIX_F32, matrix_f32, matrix_f32 ? cells * sizeof(float) : 0);
+        for (const auto& [key, lists] : neighbour_lists)
+            add(TAG_NEIGHBOURS, key.first, key.second, lists.data(), lists.size() * sizeof(int));
+
+        BinaryHeader header{};
+        std::memcpy(header.magic, binaryMagic, sizeof binaryMagic);
+        header.version = binaryVersion;
+        header.city_size = sizeof(City);
+        header.source_hash = source_hash;
+        header.source_size = source_size;
+        header.type = static_cast<int32_t>(type);
+        header.dimension = dimension;
+        header.edge_weight_type = static_cast<int32_t>(edge_weight_type);
+        header.edge_weight_format = static_cast<int32_t>(edge_weight_format);
+        header.edge_weights_packed = edge_weights_packed;
+        header.name_length = name.size();
+        header.comment_length = comment.size();
+        header.section_count = blocks.size();
+
+        auto align = [](uint64_t offset) { return (offset + 63) & ~uint64_t(63); };
+        uint64_t offset = align(headerLength(header) + blocks.size() * sizeof(BinarySection));
+        for (Block& b : blocks) {
+            b.section.offset = offset;
+            offset = align(offset + b.section.bytes);
+        }
+
+        std::error_code ec;
+        std::filesystem::path path(cache_path);
+        if (path.has_parent_path()) std::filesystem::create_directories(path.parent_path(), ec);
+        std::string temp = cache_path + ".tmp" + std::to_string(uniqueSuffix());
+        {
+            std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+            if (!out) return false;
+            out.write(reinterpret_cast<const char*>(&header), sizeof header);
+            out.write(name.data(), name.size());
+            out.write(comment.data(), comment.size());
+            for (const Block& b : blocks) out.write(reinterpret_cast<const char*>(&b.section), sizeof b.section);
+            uint64_t written = headerLength(header) + blocks.size() * sizeof(BinarySection);
+            const char zeros[64] = {};
+            for (const Block& b : blocks) {
+                out.write(zeros, b.section.offset - written);
+                out.write(static_cast<const char*>(b.data), b.section.bytes);
+                written = b.section.offset + b.section.bytes;
+            }
+            if (!out) {
+                out.close();
+                std::filesystem::remove(temp, ec);
+                return false;
+            }
+        }
+        std::filesystem::rename(temp, cache_path, ec);
+        if (ec) {
+            std::filesystem::remove(temp, ec);
+            return false;
+        }
+        cache_dirty = false;
+        return true;
+    }
+
+    // Listas de k vizinhos guardadas para a matriz atual (ver ListaCandidatos), ou nullptr
+    const std::vector<int>* getNeighbourLists(int k) const {
+        auto it = neighbour_lists.find({k, static_cast<int>(matrix_type)});
+        return it == neighbour_lists.end() ? nullptr : &it->second;
+    }
 
-        file.close();
+    void setNeighbourLists(int k, const std::vector<int>& lists) {
+        std::vector<int>& stored = neighbour_lists[{k, static_cast<int>(matrix_type)}];
+        if (stored == lists) return;
+        stored = lists;
+        cache_dirty = cache_enabled;
     }
 
     double getDistance(int i, int j) const {
@@ -294,21 +797,72 @@ public:
         if (i < 0 || i >= dimension || j < 0 || j >= dimension) {
             throw std::out_of_range("Índices de cidade inválidos");
         }
-        
-        if (edge_weight_type == EdgeWeightType::EXPLICIT) {
-            return edge_weights[i][j];
+        return getDistanceFast(i, j);
+    }
+
+    // Acesso sem verificação de índices, para os laços internos do SA
+    inline double getDistanceFast(int i, int j) const {
+        switch (matrix_type) {
+            case DistanceMatrixType::INT32: return matrix_i32[static_cast<size_t>(i) * dimension + j];
+            case DistanceMatrixType::FLOAT32: return matrix_f32[static_cast<size_t>(i) * dimension + j];
+            default: return computeDistance(i, j);
         }
-        
-        const City& a = cities[i];
-        const City& b = cities[j];
-        
-        switch (edge_weight_type) {
-            case EdgeWeightType::EUC_2D: return euclideanDistance2D(a, b);
-            case EdgeWeightType::MAN_2D: return manhattanDistance2D(a, b);
-            case EdgeWeightType::GEO: return geographicalDistance(a, b);
-            case EdgeWeightType::ATT: return attDistance(a, b);
-            default: throw std::runtime_error("Tipo de distância não implementado");
+    }
+
+    // Pré-calcula todas as distâncias numa matriz contígua; chamar após loadFromFile
+    void buildDistanceMatrix(DistanceMatrixType type = DistanceMatrixType::INT32) {
+        releaseDistanceMatrix();
+        if (type == DistanceMatrixType::NONE || dimension <= 0) return;
+        // Pesos EXPLICIT já são inteiros num buffer contíguo; uma cópia completa só dobraria a memória
+        if (edge_weight_type == EdgeWeightType::EXPLICIT && type == DistanceMatrixType::INT32) return;
+
+        const size_t n = static_cast<size_t>(dimension);
+        // Matriz do cache binário: usada no lugar, sem cópia
+        uint64_t bytes;
+        const char* cached = findCachedSection(type == DistanceMatrixType::INT32 ? TAG_MATRIX_I32 : TAG_MATRIX_F32, 0, 0, bytes);
+        const size_t elemento = type == DistanceMatrixType::INT32 ? sizeof(int32_t) : sizeof(float);
+        if (cached && bytes == n * n * elemento) {
+            matrix_owner = cache_file;
+            if (type == DistanceMatrixType::INT32) matrix_i32 = reinterpret_cast<const int32_t*>(cached);
+            else matrix_f32 = reinterpret_cast<const float*>(cached);
+            matrix_type = type;
+            return;
+        }
+        cache_dirty = cache_enabled;
+
+        if (type == DistanceMatrixType::INT32) {
+            auto matrix = std::make_shared<std::vector<int32_t>>(n * n, 0);
+            std::vector<int32_t>& m = *matrix;
+            for (int i = 0; i < dimension; ++i) {
+                for (int j = i + 1; j < dimension; ++j) {
+                    m[i * n + j] = roundedDistance(i, j);
+                    m[j * n + i] = (edge_weight_type == EdgeWeightType::EXPLICIT)
+                                       ? roundedDistance(j, i) : m[i * n + j];
+                }
+            }
+            matrix_owner = matrix;
+            matrix_i32 = m.data();
+        } else {
+            auto matrix = std::make_shared<std::vector<float>>(n * n, 0.0f);
+            std::vector<float>& m = *matrix;
+            for (int i = 0; i < dimension; ++i) {
+                for (int j = i + 1; j < dimension; ++j) {
+                    m[i * n + j] = static_cast<float>(roundedDistance(i, j));
+                    m[j * n + i] = (edge_weight_type == EdgeWeightType::EXPLICIT)
+                                       ? static_cast<float>(roundedDistance(j, i)) : m[i * n + j];
+                }
+            }
+            matrix_owner = matrix;
+            matrix_f32 = m.data();
         }
+        matrix_type = type;
+    }
+
+    void releaseDistanceMatrix() {
+        matrix_type = DistanceMatrixType::NONE;
+        matrix_owner.reset();
+        matrix_i32 = nullptr;
+        matrix_f32 = nullptr;
     }
 
     // Getters
@@ -319,7 +873,12 @@ public:
     EdgeWeightType getEdgeWeightType() const { return edge_weight_type; }
     EdgeWeightFormat getEdgeWeightFormat() const { return edge_weight_format; }
     const std::vector<City>& getCities() const { return cities; }
-    const std::vector<std::vector<int>>& getEdgeWeights() const { return edge_weights; }
+    const std::vector<int>& getEdgeWeights() const { return edge_weights; }
+    bool isEdgeWeightsPacked() const { return edge_weights_packed; }
+    DistanceMatrixType getDistanceMatrixType() const { return matrix_type; }
+    // dimension x dimension em ordem de linhas, ou nullptr sem matriz desse tipo
+    const int32_t* getDistanceMatrixI32() const { return matrix_i32; }
+    const float* getDistanceMatrixF32() const { return matrix_f32; }
 };
 #endif
 // Exemplo: 
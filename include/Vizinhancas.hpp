@@ -0,0 +1,351 @@
+#ifndef VIZINHANCAS_HPP
+#define VIZINHANCAS_HPP
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "Movimento.hpp"
+#include "Rng.hpp"
+#include "Rota.hpp"
+#include "RotaDuasCamadas.hpp"
+#include "ListaCandidatos.hpp"
+
+// Deltas e geradores de vizinhança sobre qualquer política de distância d(i, j)
+// (ver PoliticasDistancia.hpp). As versões com TSPInstance em FuncoesAuxiliares
+// são instâncias destas com DistanciaInstancia; o núcleo especializado do SA
+// (SAEspecializado.hpp) as instancia com a política da métrica da instância.
+
+template <class Dist>
+double calcularDeltaInsertion(const std::vector<int>& rota, int pos_remover, int pos_inserir, const Dist& d) {
+    int n = rota.size();
+    if (pos_remover == pos_inserir) return 0;
+
+    auto mod = [n](int x) { return (x + n) % n; };
+
+    int cidade = rota[pos_remover];
+    int antes_remover = rota[mod(pos_remover - 1)];
+    int depois_remover = rota[mod(pos_remover + 1)];
+
+    double custo_antes = d(antes_remover, cidade) +
+                         d(cidade, depois_remover);
+    double custo_depois = d(antes_remover, depois_remover);
+
+    // Vizinhos da posição de inserção, lidos da rota original sem copiá-la:
+    // o índice q da rota sem a cidade corresponde a q (q < pos_remover) ou q + 1
+    auto semCidade = [&](int q) { return rota[q < pos_remover ? q : q + 1]; };
+    int antes_inserir = semCidade(pos_inserir > 0 ? pos_inserir - 1 : n - 2);
+    int depois_inserir = semCidade(pos_inserir < n - 1 ? pos_inserir : 0);
+
+    double custo_antigo = d(antes_inserir, depois_inserir);
+    double custo_novo = d(antes_inserir, cidade) +
+                        d(cidade, depois_inserir);
+
+    return (custo_depois - custo_antes) + (custo_novo - custo_antigo);
+}
+
+template <class Dist>
+Movimento gerarVizinhaInsertionComDelta(const std::vector<int>& rota, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 2) return {};
+
+    int pos_remover = rng.inteiro(n);
+    int pos_inserir = rng.inteiro(n - 1);
+    while (pos_inserir == pos_remover) {
+        pos_inserir = rng.inteiro(n - 1);
+    }
+
+    double delta = calcularDeltaInsertion(rota, pos_remover, pos_inserir, d);
+    return {TipoMovimento::Insertion, pos_remover, pos_inserir, 0, false, delta};
+}
+
+template <class Dist>
+double calcularDeltaSwap(const std::vector<int>& rota, int i, int j, const Dist& d) {
+    int n = rota.size();
+    if (i == j) return 0.0;
+    if (i > j) std::swap(i, j);
+
+    // A última e a primeira posição também são vizinhas no ciclo
+    bool adjacentes = (i + 1 == j);
+    if (i == 0 && j == n - 1 && n > 2) {
+        std::swap(i, j);
+        adjacentes = true;
+    }
+
+    auto mod = [n](int x) { return (x + n) % n; };
+
+    int a = rota[i];
+    int b = rota[j];
+
+    int a_ant = rota[mod(i - 1)];
+    int a_prox = rota[mod(i + 1)];
+    int b_ant = rota[mod(j - 1)];
+    int b_prox = rota[mod(j + 1)];
+
+    double custoAntes = 0.0;
+    double custoDepois = 0.0;
+
+    if (adjacentes) {
+        custoAntes += d(a_ant, a) + d(b, b_prox);
+        custoAntes += d(a, b);
+
+        custoDepois += d(a_ant, b) + d(a, b_prox);
+        custoDepois += d(b, a);
+    } else {
+        custoAntes += d(a_ant, a) + d(a, a_prox);
+        custoAntes += d(b_ant, b) + d(b, b_prox);
+
+        custoDepois += d(a_ant, b) + d(b, a_prox);
+        custoDepois += d(b_ant, a) + d(a, b_prox);
+    }
+
+    return custoDepois - custoAntes;
+}
+
+template <class Dist>
+Movimento gerarVizinhaSwapComDelta(const std::vector<int>& rota, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 1) return {};
+
+    int i = rng.inteiro(n);
+    int j = rng.inteiro(n);
+    while (i == j) j = rng.inteiro(n);
+
+    double delta = calcularDeltaSwap(rota, i, j, d);
+    return {TipoMovimento::Swap, i, j, 0, false, delta};
+}
+
+template <class Dist>
+double calcularDelta2opt(const std::vector<int>& rota, int i, int j, const Dist& dist) {
+    int n = rota.size();
+    if (i > j) std::swap(i, j);
+
+    int a = rota[i];
+    int b = rota[i + 1];
+    int c = rota[j];
+    int d = rota[(j + 1) % n];
+
+    return dist(a, c) + dist(b, d)
+         - dist(a, b) - dist(c, d);
+}
+
+template <class Dist>
+Movimento gerarVizinha2optComDelta(const std::vector<int>& rota, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 3) return {};
+
+    // i e j não podem ser vizinhos, nem as pontas da rota (mesmas arestas)
+    int i, j;
+    do {
+        i = rng.inteiro(n);
+        j = rng.inteiro(n);
+        if (i > j) std::swap(i, j);
+    } while (j - i < 2 || (i == 0 && j == n - 1));
+
+    double delta = calcularDelta2opt(rota, i, j, d);
+    return {TipoMovimento::TwoOpt, i, j, 0, false, delta};
+}
+
+template <class Dist>
+double calcularDeltaOrOpt(const std::vector<int>& rota, int i, int k, int j, bool invertido, const Dist& d) {
+    int n = rota.size();
+
+    int p = rota[(i - 1 + n) % n];
+    int s1 = rota[i];
+    int s2 = rota[i + k - 1];
+    int q = rota[(i + k) % n];
+    int u = rota[j];
+    int v = rota[(j + 1) % n];
+
+    double removido = d(p, s1) + d(s2, q)
+                    + d(u, v);
+    double inserido = d(p, q)
+                    + (invertido ? d(u, s2) + d(s1, v)
+                                 : d(u, s1) + d(s2, v));
+    return inserido - removido;
+}
+
+template <class Dist>
+Movimento gerarVizinhaOrOptComDelta(const std::vector<int>& rota, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 4) return {};
+
+    // Trecho de 1 a 3 cidades que não dá a volta no fim do vetor
+    int k = 1 + rng.inteiro(std::min(3, n - 3));
+    int i = rng.inteiro(n - k + 1);
+
+    // j fora do trecho e diferente da posição anterior a ele
+    int anterior = (i - 1 + n) % n;
+    int j;
+    do {
+        j = rng.inteiro(n);
+    } while (j == anterior || (j >= i && j < i + k));
+
+    bool invertido = rng.inteiro(2);
+    double delta = calcularDeltaOrOpt(rota, i, k, j, invertido, d);
+    return {TipoMovimento::OrOpt, i, j, k, invertido, delta};
+}
+
+// Sorteia uma cidade e um de seus vizinhos na lista de candidatos
+inline std::pair<int, int> sortearParCandidato(const Rota& rota, const ListaCandidatos& candidatos, Rng& rng) {
+    int a = rng.inteiro(rota.size());
+    int b = candidatos.vizinhosDe(a)[rng.inteiro(candidatos.getK())];
+    return {a, b};
+}
+
+template <class Dist>
+Movimento gerarVizinhaSwapCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const Dist& d, Rng& rng) {
+    if (rota.size() <= 3 || candidatos.getK() == 0) return {};
+
+    auto [a, b] = sortearParCandidato(rota, candidatos, rng);
+    int alvo = rng.inteiro(2) ? rota.proxima(b) : rota.anterior(b);
+    if (alvo == a) return {};
+
+    int i = rota.posicao(a);
+    int j = rota.posicao(alvo);
+    double delta = calcularDeltaSwap(rota.getCidades(), i, j, d);
+    return {TipoMovimento::Swap, i, j, 0, false, delta};
+}
+
+template <class Dist>
+Movimento gerarVizinhaInsertionCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 3 || candidatos.getK() == 0) return {};
+
+    auto [a, b] = sortearParCandidato(rota, candidatos, rng);
+    int pos_remover = rota.posicao(a);
+    int pos_b = rota.posicao(b);
+
+    // Índice de b na rota sem a; insere-se logo depois ou logo antes dele
+    int qb = pos_b < pos_remover ? pos_b : pos_b - 1;
+    int pos_inserir = rng.inteiro(2) ? qb + 1 : qb;
+    if (pos_inserir == pos_remover) return {};
+
+    double delta = calcularDeltaInsertion(rota.getCidades(), pos_remover, pos_inserir, d);
+    return {TipoMovimento::Insertion, pos_remover, pos_inserir, 0, false, delta};
+}
+
+template <class Dist>
+Movimento gerarVizinha2optCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 3 || candidatos.getK() == 0) return {};
+
+    auto [a, b] = sortearParCandidato(rota, candidatos, rng);
+    int i = rota.posicao(a);
+    int j = rota.posicao(b);
+
+    // Cria a aresta (a, b) ligando as sucessoras (i, j) ou as antecessoras (i - 1, j - 1)
+    if (rng.inteiro(2)) {
+        i = (i - 1 + n) % n;
+        j = (j - 1 + n) % n;
+    }
+    if (i > j) std::swap(i, j);
+    if (j - i < 2 || (i == 0 && j == n - 1)) return {};
+
+    double delta = calcularDelta2opt(rota.getCidades(), i, j, d);
+    return {TipoMovimento::TwoOpt, i, j, 0, false, delta};
+}
+
+template <class Dist>
+Movimento gerarVizinhaOrOptCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 4 || candidatos.getK() == 0) return {};
+
+    auto [a, b] = sortearParCandidato(rota, candidatos, rng);
+    int i = rota.posicao(a);
+    int k = std::min(1 + rng.inteiro(3), n - i);
+
+    // Trecho começando em a, posto logo depois de b, ou invertido logo antes de b;
+    // nos dois casos a fica adjacente a b
+    bool invertido = rng.inteiro(2);
+    int j = invertido ? (rota.posicao(b) - 1 + n) % n : rota.posicao(b);
+    if (j == (i - 1 + n) % n || (j >= i && j < i + k)) return {};
+
+    double delta = calcularDeltaOrOpt(rota.getCidades(), i, k, j, invertido, d);
+    return {TipoMovimento::OrOpt, i, j, k, invertido, delta};
+}
+
+template <class Dist>
+Movimento gerarVizinhaDuasCamadas(const RotaDuasCamadas& rota, TipoMovimento tipo,
+                                  const ListaCandidatos* candidatos, const Dist& d, Rng& rng) {
+    int n = rota.size();
+    if (n <= 4) return {};
+    if (candidatos && candidatos->getK() == 0) candidatos = nullptr;
+
+    int a = rng.inteiro(n);
+    int b = candidatos ? candidatos->vizinhosDe(a)[rng.inteiro(candidatos->getK())] : rng.inteiro(n);
+    bool lado = rng.inteiro(2);
+
+    Movimento mov;
+    mov.tipo = tipo;
+
+    switch (tipo) {
+        case TipoMovimento::Swap: {
+            if (candidatos) b = lado ? rota.proxima(b) : rota.anterior(b);
+            if (a == b) return {};
+            if (rota.proxima(b) == a) std::swap(a, b);
+
+            int pa = rota.anterior(a), na = rota.proxima(a);
+            int pb = rota.anterior(b), nb = rota.proxima(b);
+            if (na == b)
+                mov.delta = d(pa, b) + d(a, nb) - d(pa, a) - d(b, nb);
+            else
+                mov.delta = d(pa, b) + d(b, na) + d(pb, a) + d(a, nb)
+                          - d(pa, a) - d(a, na) - d(pb, b) - d(b, nb);
+            break;
+        }
+        case TipoMovimento::Insertion: {
+            // a vai para logo depois de u
+            int u = (candidatos && lado) ? rota.anterior(b) : b;
+            int pa = rota.anterior(a), na = rota.proxima(a);
+            if (u == a || u == pa) return {};
+            int v = rota.proxima(u);
+
+            mov.delta = d(pa, na) - d(pa, a) - d(a, na) + d(u, a) + d(a, v) - d(u, v);
+            b = u;
+            break;
+        }
+        case TipoMovimento::TwoOpt: {
+            if (candidatos && lado) {
+                a = rota.anterior(a);
+                b = rota.anterior(b);
+            }
+            int na = rota.proxima(a), nb = rota.proxima(b);
+            if (a == b || na == b || nb == a) return {};
+
+            mov.delta = d(a, b) + d(na, nb) - d(a, na) - d(b, nb);
+            break;
+        }
+        case TipoMovimento::OrOpt: {
+            int k = 1 + rng.inteiro(3);
+            bool invertido = candidatos ? lado : rng.inteiro(2);
+            // Com candidatos: depois de b, ou invertido antes de b; a fica adjacente a b
+            int u = (candidatos && invertido) ? rota.anterior(b) : b;
+
+            int s2 = a;
+            for (int t = 1; t < k; ++t) s2 = rota.proxima(s2);
+            int p = rota.anterior(a), q = rota.proxima(s2);
+            if (u == p) return {};
+            for (int c = a; ; c = rota.proxima(c)) {
+                if (c == u) return {};
+                if (c == s2) break;
+            }
+            int v = rota.proxima(u);
+
+            double removido = d(p, a) + d(s2, q) + d(u, v);
+            double inserido = d(p, q) + (invertido ? d(u, s2) + d(a, v) : d(u, a) + d(s2, v));
+            mov.delta = inserido - removido;
+            mov.k = k;
+            mov.invertido = invertido;
+            b = u;
+            break;
+        }
+        default:
+            return {};
+    }
+
+    mov.a = a;
+    mov.b = b;
+    return mov;
+}
+
+#endif
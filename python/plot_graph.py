@@ -1,9 +1,43 @@
 
+import sys
+import struct
 import matplotlib.pyplot as plt
+import numpy as np
 import pandas as pd
 
-def plot_sa_results(csv_file='../output/resultado.csv'):
-    data = pd.read_csv(csv_file)
+def ler_rastro(arquivo):
+    """Lê o rastro em CSV ou no formato binário colunar de Rastro.hpp."""
+    with open(arquivo, 'rb') as f:
+        conteudo = f.read()
+    if not conteudo.startswith(b'SARASTRO'):
+        return pd.read_csv(arquivo)
+
+    versao, ncolunas = struct.unpack_from('<II', conteudo, 8)
+    if versao != 1:
+        raise ValueError(f'Versão de rastro não suportada: {versao}')
+    pos = 16
+    tipos = {b'i': '<i4', b'l': '<i8', b'd': '<f8'}
+    colunas = []
+    for _ in range(ncolunas):
+        nome, tipo = struct.unpack_from('<15sc', conteudo, pos)
+        colunas.append((nome.rstrip(b'\0').decode(), np.dtype(tipos[tipo])))
+        pos += 16
+
+    partes = {nome: [] for nome, _ in colunas}
+    while pos < len(conteudo):
+        linhas, _ = struct.unpack_from('<II', conteudo, pos)
+        pos += 8
+        for nome, tipo in colunas:
+            partes[nome].append(np.frombuffer(conteudo, dtype=tipo, count=linhas, offset=pos))
+            pos += linhas * tipo.itemsize
+    return pd.DataFrame({nome: np.concatenate(v) if v else np.array([], dtype=t)
+                         for (nome, t), v in zip(colunas, partes.values())})
+
+def plot_sa_results(arquivo='../output/resultado.csv'):
+    data = ler_rastro(arquivo)
+    # Troca de réplicas grava uma linha por degrau; plota-se o degrau mais frio
+    if 'Rung' in data.columns:
+        data = data[data['Rung'] == 0]
     
     plt.figure(figsize=(12, 5))
     
@@ -35,4 +69,4 @@ def plot_sa_results(csv_file='../output/resultado.csv'):
     plt.show()
 
 if __name__ == "__main__":
-    plot_sa_results()
+    plot_sa_results(*sys.argv[1:2])
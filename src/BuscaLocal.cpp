@@ -0,0 +1,171 @@
+#include "../include/BuscaLocal.hpp"
+#include "../include/FuncoesAuxiliares.hpp"
+#include <algorithm>
+#include <iomanip>
+
+namespace {
+constexpr double eps = 1e-9;
+constexpr int maxSegmento = 3;
+constexpr int cidadesPorVerificacao = 64;   // cidades examinadas entre consultas ao relógio
+}
+
+BuscaLocal::BuscaLocal(const TSPInstance& instance, const ListaCandidatos* candidatos)
+    : instance(instance), candidatos(candidatos) {
+    if (!this->candidatos || this->candidatos->getK() == 0) {
+        proprias = std::make_unique<ListaCandidatos>(instance, 10);
+        this->candidatos = proprias.get();
+    }
+}
+
+void BuscaLocal::ativar(int c) {
+    if (naFila[c]) return;
+    naFila[c] = 1;
+    fila[(inicioFila + tamFila) % fila.size()] = c;
+    ++tamFila;
+}
+
+// Inverte o caminho das posições i a j (no sentido da rota) ou, se for mais curto, o complemento;
+// as duas inversões dão a mesma rota cíclica
+void BuscaLocal::inverter(int i, int j) {
+    int comprimento = j - i;
+    if (comprimento < 0) comprimento += n;
+    ++comprimento;
+    if (2 * comprimento > n) {
+        int ni = j + 1 == n ? 0 : j + 1;
+        j = i == 0 ? n - 1 : i - 1;
+        i = ni;
+        comprimento = n - comprimento;
+    }
+    for (int k = 0; k < comprimento / 2; ++k) {
+        std::swap(rota[i], rota[j]);
+        pos[rota[i]] = i;
+        pos[rota[j]] = j;
+        if (++i == n) i = 0;
+        if (--j < 0) j = n - 1;
+    }
+}
+
+// Remove (t1,t2) e (t3,t4) e liga (t1,t3) e (t2,t4); t2 segue t1 e t4 segue t3 no mesmo sentido
+void BuscaLocal::mover2opt(int t1, int t2, int t3, int t4) {
+    (void)t4;
+    if (sucessor(t1) == t2) inverter(pos[t2], pos[t3]);
+    else inverter(pos[t3], pos[t2]);
+}
+
+bool BuscaLocal::tentar2opt(int t1, double& custo) {
+    const int k = candidatos->getK();
+    const int* viz = candidatos->vizinhosDe(t1);
+    for (int sentido = 0; sentido < 2; ++sentido) {
+        const int t2 = sentido == 0 ? sucessor(t1) : antecessor(t1);
+        const double d12 = dist(t1, t2);
+        for (int v = 0; v < k; ++v) {
+            const int t3 = viz[v];
+            const double d13 = dist(t1, t3);
+            if (d13 >= d12) break;
+            const int t4 = sentido == 0 ? sucessor(t3) : antecessor(t3);
+            if (t3 == t2 || t4 == t1) continue;
+            const double delta = d13 + dist(t2, t4) - d12 - dist(t3, t4);
+            if (delta < -eps) {
+                mover2opt(t1, t2, t3, t4);
+                custo += delta;
+                ativar(t1); ativar(t2); ativar(t3); ativar(t4);
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+// Move o segmento s1..s2 (até maxSegmento cidades, no sentido da rota, entre a e b) para a aresta
+// (x,y) de um candidato de s1 ou de s2, na orientação que custar menos
+bool BuscaLocal::tentarOrOpt(int t, double& custo) {
+    const int k = candidatos->getK();
+    for (int comprimento = 1; comprimento <= maxSegmento; ++comprimento) {
+        for (int lado = 0; lado < (comprimento == 1 ? 1 : 2); ++lado) {
+            // Segmento que começa em t ou que termina em t
+            int s1 = t;
+            if (lado == 1) for (int c = 1; c < comprimento; ++c) s1 = antecessor(s1);
+            int s2 = s1;
+            for (int c = 1; c < comprimento; ++c) s2 = sucessor(s2);
+            const int a = antecessor(s1), b = sucessor(s2);
+            const double ganhoRemocao = dist(a, s1) + dist(s2, b) - dist(a, b);
+            if (ganhoRemocao <= eps) continue;
+
+            auto noSegmento = [&](int c) {
+                int desloc = pos[c] - pos[s1];
+                if (desloc < 0) desloc += n;
+                return desloc < comprimento;
+            };
+
+            for (int ponta = 0; ponta < (comprimento == 1 ? 1 : 2); ++ponta) {
+                const int s = ponta == 0 ? s1 : s2;
+                const int* viz = candidatos->vizinhosDe(s);
+                for (int v = 0; v < k; ++v) {
+                    const int c = viz[v];
+                    if (dist(s, c) >= ganhoRemocao) break;
+                    if (noSegmento(c)) continue;
+                    for (int aresta = 0; aresta < 2; ++aresta) {
+                        const int x = aresta == 0 ? c : antecessor(c);
+                        const int y = aresta == 0 ? sucessor(c) : c;
+                        if (noSegmento(x) || noSegmento(y)) continue;
+                        const double direto = dist(x, s1) + dist(s2, y);
+                        const double invertido = dist(x, s2) + dist(s1, y);
+                        const double delta = std::min(direto, invertido) - dist(x, y) - ganhoRemocao;
+                        if (delta >= -eps) continue;
+
+                        // a s1..s2 b ... x y  ->  a b ... x s2..s1 y  (-> x s1..s2 y)
+                        mover2opt(a, s1, x, y);
+                        mover2opt(a, x, b, s2);
+                        if (direto < invertido) mover2opt(x, s2, s1, y);
+                        custo += delta;
+                        ativar(a); ativar(b); ativar(s1); ativar(s2); ativar(x); ativar(y);
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+    return false;
+}
+
+long long BuscaLocal::otimizar(std::vector<int>& rotaEntrada, double& custo,
+                               std::chrono::steady_clock::time_point prazo) {
+    n = rotaEntrada.size();
+    if (n < 8) return 0;
+
+    rota = rotaEntrada;
+    pos.assign(n, 0);
+    for (int i = 0; i < n; ++i) pos[rota[i]] = i;
+    fila.assign(n, 0);
+    naFila.assign(n, 0);
+    inicioFila = tamFila = 0;
+    for (int c : rota) ativar(c);
+
+    const bool comPrazo = prazo != std::chrono::steady_clock::time_point::max();
+    long long movimentos = 0;
+    for (long long examinadas = 0; tamFila > 0; ++examinadas) {
+        if (comPrazo && examinadas % cidadesPorVerificacao == 0 && std::chrono::steady_clock::now() >= prazo) break;
+        const int t = fila[inicioFila];
+        inicioFila = (inicioFila + 1) % fila.size();
+        --tamFila;
+        naFila[t] = 0;
+        while (tentar2opt(t, custo) || tentarOrOpt(t, custo)) ++movimentos;
+    }
+
+    if (movimentos > 0) {
+        rotaEntrada = rota;
+        custo = calcularCusto(rotaEntrada, instance);
+    }
+    return movimentos;
+}
+
+void ResumoBuscaLocal::imprimir(std::ostream& out) const {
+    if (chamadas == 0) return;
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precisao = out.precision();
+    out << std::fixed << std::setprecision(2)
+        << "Busca local: " << chamadas << " chamadas, " << movimentos << " movimentos, custo -"
+        << melhoria << " em " << std::setprecision(4) << segundos << " s\n";
+    out.flags(flags);
+    out.precision(precisao);
+}
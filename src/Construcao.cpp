@@ -0,0 +1,398 @@
+#include "../include/Construcao.hpp"
+#include "../include/FuncoesAuxiliares.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+using Cidades = std::vector<TSPInstance::City>;
+
+bool temCoordenadas(const TSPInstance& instance) {
+    return instance.getEdgeWeightType() != TSPInstance::EdgeWeightType::EXPLICIT &&
+           instance.getCities().size() == static_cast<size_t>(instance.getDimension());
+}
+
+// Grade uniforme sobre as coordenadas de um subconjunto das cidades (todas, por padrão; cerca de
+// duas por célula) com remoção em O(1)
+class GradeCidades {
+private:
+    const Cidades& cidades;
+    double x0 = 0, y0 = 0, lado = 1;
+    int colunas = 1, linhas = 1;
+    std::vector<std::vector<int>> celulas;
+    std::vector<int> celulaDe, posicao;
+    int restantes;
+
+    int indiceX(double x) const { return std::clamp(static_cast<int>((x - x0) / lado), 0, colunas - 1); }
+    int indiceY(double y) const { return std::clamp(static_cast<int>((y - y0) / lado), 0, linhas - 1); }
+
+    static std::vector<int> todas(int n) {
+        std::vector<int> ids(n);
+        std::iota(ids.begin(), ids.end(), 0);
+        return ids;
+    }
+
+public:
+    explicit GradeCidades(const Cidades& cidades) : GradeCidades(cidades, todas(cidades.size())) {}
+
+    GradeCidades(const Cidades& cidades, const std::vector<int>& ids) : cidades(cidades), restantes(ids.size()) {
+        const int m = ids.size();
+        double x1 = x0, y1 = y0;
+        if (m > 0) {
+            x0 = x1 = cidades[ids[0]].x;
+            y0 = y1 = cidades[ids[0]].y;
+        }
+        for (int c : ids) {
+            x0 = std::min(x0, cidades[c].x); x1 = std::max(x1, cidades[c].x);
+            y0 = std::min(y0, cidades[c].y); y1 = std::max(y1, cidades[c].y);
+        }
+        double largura = std::max(x1 - x0, 1e-9), altura = std::max(y1 - y0, 1e-9);
+        lado = std::sqrt(largura * altura / std::max(1.0, m / 2.0));
+        lado = std::max({lado, largura / 4096, altura / 4096});
+        colunas = static_cast<int>(largura / lado) + 1;
+        linhas = static_cast<int>(altura / lado) + 1;
+
+        celulas.resize(static_cast<size_t>(colunas) * linhas);
+        celulaDe.resize(cidades.size());
+        posicao.resize(cidades.size());
+        for (int c : ids) {
+            celulaDe[c] = indiceY(cidades[c].y) * colunas + indiceX(cidades[c].x);
+            posicao[c] = celulas[celulaDe[c]].size();
+            celulas[celulaDe[c]].push_back(c);
+        }
+    }
+
+    void remover(int c) {
+        std::vector<int>& celula = celulas[celulaDe[c]];
+        int ultima = celula.back();
+        celula[posicao[c]] = ultima;
+        posicao[ultima] = posicao[c];
+        celula.pop_back();
+        --restantes;
+    }
+
+    // Cidade restante mais próxima de c pela distância euclidiana das coordenadas, em anéis de
+    // células; -1 se não houver
+    int maisProxima(int c) const {
+        if (restantes == 0) return -1;
+        const int cx = indiceX(cidades[c].x), cy = indiceY(cidades[c].y);
+        double melhor = std::numeric_limits<double>::infinity();
+        int escolhida = -1;
+
+        for (int r = 0; r <= std::max(colunas, linhas); ++r) {
+            for (int gy = std::max(0, cy - r); gy <= std::min(linhas - 1, cy + r); ++gy) {
+                const bool borda = gy == cy - r || gy == cy + r;
+                const int passo = borda || r == 0 ? 1 : 2 * r;
+                for (int gx = cx - r; gx <= cx + r; gx += passo) {
+                    if (gx < 0 || gx >= colunas) continue;
+                    for (int o : celulas[static_cast<size_t>(gy) * colunas + gx]) {
+                        double dx = cidades[o].x - cidades[c].x, dy = cidades[o].y - cidades[c].y;
+                        double d2 = dx * dx + dy * dy;
+                        if (d2 < melhor) {
+                            melhor = d2;
+                            escolhida = o;
+                        }
+                    }
+                }
+            }
+            // As células fora dos anéis já vistos estão a pelo menos r * lado de c
+            if (escolhida >= 0 && melhor <= (r * lado) * (r * lado)) break;
+        }
+        return escolhida;
+    }
+};
+
+std::vector<int> vizinhoMaisProximo(const TSPInstance& instance, const ListaCandidatos& candidatos, Rng& rng) {
+    const int n = instance.getDimension();
+    std::vector<char> visitada(n, 0);
+    std::unique_ptr<GradeCidades> grade;
+    if (temCoordenadas(instance)) grade = std::make_unique<GradeCidades>(instance.getCities());
+
+    std::vector<int> rota;
+    rota.reserve(n);
+    int atual = rng.inteiro(n);
+    for (;;) {
+        rota.push_back(atual);
+        visitada[atual] = 1;
+        if (grade) grade->remover(atual);
+        if (static_cast<int>(rota.size()) == n) break;
+
+        // Listas de candidatos em ordem crescente de distância; esgotadas, a grade ou uma varredura
+        int proxima = -1;
+        const int* vizinhos = candidatos.vizinhosDe(atual);
+        for (int t = 0; t < candidatos.getK() && proxima < 0; ++t)
+            if (!visitada[vizinhos[t]]) proxima = vizinhos[t];
+        if (proxima < 0 && grade) proxima = grade->maisProxima(atual);
+        if (proxima < 0) {
+            double melhor = std::numeric_limits<double>::infinity();
+            for (int c = 0; c < n; ++c) {
+                if (visitada[c]) continue;
+                double d = instance.getDistanceFast(atual, c);
+                if (d < melhor) {
+                    melhor = d;
+                    proxima = c;
+                }
+            }
+        }
+        atual = proxima;
+    }
+    return rota;
+}
+
+struct UniaoBusca {
+    std::vector<int> pai, tamanho;
+
+    explicit UniaoBusca(int n) : pai(n), tamanho(n, 1) { std::iota(pai.begin(), pai.end(), 0); }
+
+    int raiz(int a) {
+        while (pai[a] != a) a = pai[a] = pai[pai[a]];
+        return a;
+    }
+
+    bool unir(int a, int b) {
+        a = raiz(a);
+        b = raiz(b);
+        if (a == b) return false;
+        if (tamanho[a] < tamanho[b]) std::swap(a, b);
+        pai[b] = a;
+        tamanho[a] += tamanho[b];
+        return true;
+    }
+};
+
+struct Aresta {
+    double chave;
+    int a, b;
+    bool operator<(const Aresta& o) const {
+        if (chave != o.chave) return chave < o.chave;
+        return a != o.a ? a < o.a : b < o.b;
+    }
+};
+
+// Aceita as arestas em ordem crescente de chave mantendo grau <= 2 e sem ciclos; os caminhos
+// resultantes são encadeados a partir do que contém 'inicio', sempre pelo extremo mais próximo,
+// procurado numa grade sobre os extremos (sem coordenadas, numa varredura dos fragmentos)
+std::vector<int> unirArestas(const TSPInstance& instance, std::vector<Aresta>& arestas, int inicio) {
+    const int n = instance.getDimension();
+    std::sort(arestas.begin(), arestas.end());
+
+    std::vector<std::array<int, 2>> adj(n, {-1, -1});
+    std::vector<int> grau(n, 0);
+    UniaoBusca conjuntos(n);
+    for (const Aresta& e : arestas) {
+        if (grau[e.a] < 2 && grau[e.b] < 2 && conjuntos.unir(e.a, e.b)) {
+            adj[e.a][grau[e.a]++] = e.b;
+            adj[e.b][grau[e.b]++] = e.a;
+        }
+    }
+
+    // Fragmentos: caminhos percorridos a partir de um extremo
+    std::vector<std::vector<int>> fragmentos;
+    std::vector<int> fragmentoDe(n, -1);
+    for (int c = 0; c < n; ++c) {
+        if (grau[c] == 2 || fragmentoDe[c] >= 0) continue;
+        std::vector<int> caminho;
+        for (int anterior = -1, atual = c; atual >= 0;) {
+            caminho.push_back(atual);
+            fragmentoDe[atual] = fragmentos.size();
+            int proxima = adj[atual][0] != anterior ? adj[atual][0] : adj[atual][1];
+            anterior = atual;
+            atual = proxima;
+        }
+        fragmentos.push_back(std::move(caminho));
+    }
+
+    std::unique_ptr<GradeCidades> grade;
+    if (temCoordenadas(instance)) {
+        std::vector<int> extremos;
+        for (const std::vector<int>& caminho : fragmentos) {
+            extremos.push_back(caminho.front());
+            if (caminho.size() > 1) extremos.push_back(caminho.back());
+        }
+        grade = std::make_unique<GradeCidades>(instance.getCities(), extremos);
+    }
+
+    std::vector<int> rota;
+    rota.reserve(n);
+    std::vector<char> usado(fragmentos.size(), 0);
+    int f = fragmentoDe[inicio];
+    bool invertido = false;
+    for (size_t usados = 0; usados < fragmentos.size(); ++usados) {
+        usado[f] = 1;
+        if (invertido) rota.insert(rota.end(), fragmentos[f].rbegin(), fragmentos[f].rend());
+        else rota.insert(rota.end(), fragmentos[f].begin(), fragmentos[f].end());
+
+        const int extremo = rota.back();
+        if (grade) {
+            grade->remover(fragmentos[f].front());
+            if (fragmentos[f].size() > 1) grade->remover(fragmentos[f].back());
+            int proximo = grade->maisProxima(extremo);
+            if (proximo < 0) break;
+            f = fragmentoDe[proximo];
+            invertido = proximo != fragmentos[f].front();
+            continue;
+        }
+        double melhor = std::numeric_limits<double>::infinity();
+        for (size_t g = 0; g < fragmentos.size(); ++g) {
+            if (usado[g]) continue;
+            double dInicio = instance.getDistanceFast(extremo, fragmentos[g].front());
+            double dFim = instance.getDistanceFast(extremo, fragmentos[g].back());
+            if (dInicio < melhor) { melhor = dInicio; f = g; invertido = false; }
+            if (dFim < melhor) { melhor = dFim; f = g; invertido = true; }
+        }
+    }
+    return rota;
+}
+
+std::vector<int> gulosa(const TSPInstance& instance, const ListaCandidatos& candidatos) {
+    const int n = instance.getDimension();
+    std::vector<Aresta> arestas;
+    arestas.reserve(static_cast<size_t>(n) * candidatos.getK());
+    for (int c = 0; c < n; ++c) {
+        const int* vizinhos = candidatos.vizinhosDe(c);
+        for (int t = 0; t < candidatos.getK(); ++t) {
+            int v = vizinhos[t];
+            arestas.push_back({instance.getDistanceFast(c, v), std::min(c, v), std::max(c, v)});
+        }
+    }
+    return unirArestas(instance, arestas, 0);
+}
+
+// Cidade mais próxima do centróide das coordenadas; sem coordenadas, a de menor soma das
+// distâncias aos seus candidatos
+int cidadeCentral(const TSPInstance& instance, const ListaCandidatos& candidatos) {
+    const int n = instance.getDimension();
+    int central = 0;
+    double melhor = std::numeric_limits<double>::infinity();
+    if (temCoordenadas(instance)) {
+        const Cidades& cidades = instance.getCities();
+        double mx = 0, my = 0;
+        for (const auto& c : cidades) {
+            mx += c.x;
+            my += c.y;
+        }
+        mx /= n;
+        my /= n;
+        for (int c = 0; c < n; ++c) {
+            double d = std::hypot(cidades[c].x - mx, cidades[c].y - my);
+            if (d < melhor) { melhor = d; central = c; }
+        }
+        return central;
+    }
+    for (int c = 0; c < n; ++c) {
+        double soma = 0;
+        const int* vizinhos = candidatos.vizinhosDe(c);
+        for (int t = 0; t < candidatos.getK(); ++t) soma += instance.getDistanceFast(c, vizinhos[t]);
+        if (soma < melhor) { melhor = soma; central = c; }
+    }
+    return central;
+}
+
+// Clarke-Wright: s(i, j) = d(h, i) + d(h, j) - d(i, j) em ordem decrescente, sem arestas da central h
+std::vector<int> economias(const TSPInstance& instance, const ListaCandidatos& candidatos) {
+    const int n = instance.getDimension();
+    const int h = cidadeCentral(instance, candidatos);
+    std::vector<Aresta> arestas;
+    arestas.reserve(static_cast<size_t>(n) * candidatos.getK());
+    for (int c = 0; c < n; ++c) {
+        if (c == h) continue;
+        const int* vizinhos = candidatos.vizinhosDe(c);
+        for (int t = 0; t < candidatos.getK(); ++t) {
+            int v = vizinhos[t];
+            if (v == h) continue;
+            double economia = instance.getDistanceFast(h, c) + instance.getDistanceFast(h, v) - instance.getDistanceFast(c, v);
+            arestas.push_back({-economia, std::min(c, v), std::max(c, v)});
+        }
+    }
+    return unirArestas(instance, arestas, h);
+}
+
+// Índice de (x, y) na curva de Hilbert de lado 2^16
+uint64_t indiceHilbert(uint32_t x, uint32_t y) {
+    const uint32_t lado = 1u << 16;
+    uint64_t d = 0;
+    for (uint32_t s = lado / 2; s > 0; s /= 2) {
+        uint32_t rx = (x & s) > 0;
+        uint32_t ry = (y & s) > 0;
+        d += static_cast<uint64_t>(s) * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = lado - 1 - x;
+                y = lado - 1 - y;
+            }
+            std::swap(x, y);
+        }
+    }
+    return d;
+}
+
+std::vector<int> hilbert(const TSPInstance& instance) {
+    const Cidades& cidades = instance.getCities();
+    const int n = cidades.size();
+    double x0 = cidades[0].x, x1 = x0, y0 = cidades[0].y, y1 = y0;
+    for (const auto& c : cidades) {
+        x0 = std::min(x0, c.x); x1 = std::max(x1, c.x);
+        y0 = std::min(y0, c.y); y1 = std::max(y1, c.y);
+    }
+    // Mesma escala nos dois eixos, para não distorcer a curva
+    double escala = 65535.0 / std::max({x1 - x0, y1 - y0, 1e-9});
+
+    std::vector<std::pair<uint64_t, int>> chaves(n);
+    for (int c = 0; c < n; ++c) {
+        auto x = static_cast<uint32_t>((cidades[c].x - x0) * escala);
+        auto y = static_cast<uint32_t>((cidades[c].y - y0) * escala);
+        chaves[c] = {indiceHilbert(x, y), c};
+    }
+    std::sort(chaves.begin(), chaves.end());
+
+    std::vector<int> rota(n);
+    for (int i = 0; i < n; ++i) rota[i] = chaves[i].second;
+    return rota;
+}
+
+} // namespace
+
+TipoRotaInicial tipoRotaInicial(const std::string& nome) {
+    if (nome == "Aleatoria") return TipoRotaInicial::Aleatoria;
+    if (nome == "VizinhoMaisProximo") return TipoRotaInicial::VizinhoMaisProximo;
+    if (nome == "Gulosa") return TipoRotaInicial::Gulosa;
+    if (nome == "Hilbert") return TipoRotaInicial::Hilbert;
+    if (nome == "Economias") return TipoRotaInicial::Economias;
+    throw std::runtime_error("Rota inicial inválida: " + nome);
+}
+
+const char* nomeRotaInicial(TipoRotaInicial tipo) {
+    switch (tipo) {
+        case TipoRotaInicial::VizinhoMaisProximo: return "VizinhoMaisProximo";
+        case TipoRotaInicial::Gulosa: return "Gulosa";
+        case TipoRotaInicial::Hilbert: return "Hilbert";
+        case TipoRotaInicial::Economias: return "Economias";
+        default: return "Aleatoria";
+    }
+}
+
+std::vector<int> construirRotaInicial(const TSPInstance& instance, TipoRotaInicial tipo, Rng& rng,
+                                      const ListaCandidatos* candidatos) {
+    if (tipo == TipoRotaInicial::Aleatoria || instance.getDimension() < 4)
+        return gerarRotaInicial(instance, rng);
+    if (tipo == TipoRotaInicial::Hilbert && temCoordenadas(instance))
+        return hilbert(instance);
+
+    std::unique_ptr<ListaCandidatos> proprias;
+    if (!candidatos || candidatos->getK() == 0) {
+        proprias = std::make_unique<ListaCandidatos>(instance, 10);
+        candidatos = proprias.get();
+    }
+
+    switch (tipo) {
+        case TipoRotaInicial::Gulosa: return gulosa(instance, *candidatos);
+        case TipoRotaInicial::Economias: return economias(instance, *candidatos);
+        default: return vizinhoMaisProximo(instance, *candidatos, rng);
+    }
+}
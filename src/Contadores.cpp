@@ -0,0 +1,26 @@
+#include "../include/Contadores.hpp"
+#include <iomanip>
+
+void ResumoContadores::imprimir(std::ostream& out) const {
+#if SA_CONTADORES
+    if (propostas == 0) return;
+    long long aceitos = aceitosSubida + aceitosDescida;
+    auto pct = [&](long long n) { return 100.0 * n / propostas; };
+
+    std::ios::fmtflags flags = out.flags();
+    std::streamsize precisao = out.precision();
+    out << std::fixed << std::setprecision(2)
+        << "Propostas: " << propostas << " em " << niveis << " níveis ("
+        << niveisCongelados << " congelados)\n"
+        << "  aceitas de descida: " << aceitosDescida << " (" << pct(aceitosDescida) << "%)\n"
+        << "  aceitas de subida:  " << aceitosSubida << " (" << pct(aceitosSubida) << "%)\n"
+        << "  rejeitadas:         " << propostas - aceitos << " (" << pct(propostas - aceitos) << "%)\n"
+        << "  novos melhores:     " << novosMelhores << "\n"
+        << "  tempo nos níveis:   " << nanossegundos * 1e-9 << " s ("
+        << double(nanossegundos) / propostas << " ns/proposta)\n";
+    out.flags(flags);
+    out.precision(precisao);
+#else
+    (void)out;
+#endif
+}
@@ -0,0 +1,32 @@
+#include "../include/Cronograma.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+TipoCronograma tipoCronograma(const std::string& nome) {
+    if (nome == "Geometrico") return TipoCronograma::Geometrico;
+    if (nome == "Adaptativo") return TipoCronograma::Adaptativo;
+    throw std::runtime_error("Cronograma inválido: " + nome);
+}
+
+double calibrarTemperaturaInicial(const std::vector<double>& deltasPiora, double alvo) {
+    if (deltasPiora.empty()) return 1.0;
+    alvo = std::clamp(alvo, 1e-6, 1.0 - 1e-6);
+
+    auto aceitacao = [&](double t) {
+        double soma = 0.0;
+        for (double d : deltasPiora) soma += std::exp(-d / t);
+        return soma / deltasPiora.size();
+    };
+
+    // Em hi até o maior delta é aceito com probabilidade >= alvo
+    double maior = *std::max_element(deltasPiora.begin(), deltasPiora.end());
+    double hi = maior / -std::log(alvo);
+    double lo = hi * 1e-9;
+    for (int it = 0; it < 100 && hi / lo > 1.0 + 1e-9; ++it) {
+        double meio = std::sqrt(lo * hi);
+        if (aceitacao(meio) < alvo) lo = meio;
+        else hi = meio;
+    }
+    return hi;
+}
@@ -0,0 +1,99 @@
+#include "../include/DistanciasLote.hpp"
+#include <algorithm>
+#include <cmath>
+
+#if defined(__x86_64__)
+#include <immintrin.h>
+#define DISTANCIAS_LOTE_X86 1
+#endif
+
+namespace {
+
+void distanciasEscalar(const double* x, const double* y, const int* p, const int* q, int m,
+                       double* saida) {
+    for (int k = 0; k < m; ++k) {
+        double dx = x[p[k]] - x[q[k]];
+        double dy = y[p[k]] - y[q[k]];
+        double d = std::sqrt(dx * dx + dy * dy);
+        saida[k] = std::floor(d + 0.5);
+    }
+}
+
+#ifdef DISTANCIAS_LOTE_X86
+// SSE2 faz parte da base x86-64: sem gather, os pares são carregados um a um
+void distanciasSSE2(const double* x, const double* y, const int* p, const int* q, int m,
+                    double* saida) {
+    const __m128d meio = _mm_set1_pd(0.5);
+    int k = 0;
+    for (; k + 2 <= m; k += 2) {
+        __m128d dx = _mm_sub_pd(_mm_set_pd(x[p[k + 1]], x[p[k]]), _mm_set_pd(x[q[k + 1]], x[q[k]]));
+        __m128d dy = _mm_sub_pd(_mm_set_pd(y[p[k + 1]], y[p[k]]), _mm_set_pd(y[q[k + 1]], y[q[k]]));
+        __m128d d = _mm_sqrt_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)));
+        // d >= 0: truncar d + 0.5 é o floor
+        d = _mm_cvtepi32_pd(_mm_cvttpd_epi32(_mm_add_pd(d, meio)));
+        _mm_storeu_pd(saida + k, d);
+    }
+    distanciasEscalar(x, y, p + k, q + k, m - k, saida + k);
+}
+
+__attribute__((target("avx2")))
+void distanciasAVX2(const double* x, const double* y, const int* p, const int* q, int m,
+                    double* saida) {
+    const __m256d meio = _mm256_set1_pd(0.5);
+    // Gather mascarado com origem zerada: a forma sem máscara deixa o GCC acusar origem não inicializada
+    const __m256d zero = _mm256_setzero_pd();
+    const __m256d todos = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+    int k = 0;
+    for (; k + 4 <= m; k += 4) {
+        __m128i ip = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + k));
+        __m128i iq = _mm_loadu_si128(reinterpret_cast<const __m128i*>(q + k));
+        __m256d dx = _mm256_sub_pd(_mm256_mask_i32gather_pd(zero, x, ip, todos, 8),
+                                   _mm256_mask_i32gather_pd(zero, x, iq, todos, 8));
+        __m256d dy = _mm256_sub_pd(_mm256_mask_i32gather_pd(zero, y, ip, todos, 8),
+                                   _mm256_mask_i32gather_pd(zero, y, iq, todos, 8));
+        // Multiplicação e soma separadas (sem FMA), como no código escalar
+        __m256d d = _mm256_sqrt_pd(_mm256_add_pd(_mm256_mul_pd(dx, dx), _mm256_mul_pd(dy, dy)));
+        d = _mm256_floor_pd(_mm256_add_pd(d, meio));
+        _mm256_storeu_pd(saida + k, d);
+    }
+    distanciasEscalar(x, y, p + k, q + k, m - k, saida + k);
+}
+#endif
+
+}
+
+DistanciasLote::DistanciasLote(const TSPInstance& instance, Isa isaMaxima) : instance(instance) {
+    using Matriz = TSPInstance::DistanceMatrixType;
+    Matriz matriz = instance.getDistanceMatrixType();
+
+    usarCoordenadas = instance.getEdgeWeightType() == TSPInstance::EdgeWeightType::EUC_2D
+                   && (matriz == Matriz::NONE || matriz == Matriz::INT32);
+    if (!usarCoordenadas) return;
+
+    const auto& cidades = instance.getCities();
+    x.resize(cidades.size());
+    y.resize(cidades.size());
+    for (size_t c = 0; c < cidades.size(); ++c) {
+        x[c] = cidades[c].x;
+        y[c] = cidades[c].y;
+    }
+
+#ifdef DISTANCIAS_LOTE_X86
+    if (isaMaxima == Isa::AVX2 && __builtin_cpu_supports("avx2")) isa = Isa::AVX2;
+    else if (isaMaxima != Isa::Escalar) isa = Isa::SSE2;
+#endif
+}
+
+void DistanciasLote::calcular(const int* p, const int* q, int m, double* saida) const {
+    if (!usarCoordenadas) {
+        for (int k = 0; k < m; ++k) saida[k] = instance.getDistanceFast(p[k], q[k]);
+        return;
+    }
+    switch (isa) {
+#ifdef DISTANCIAS_LOTE_X86
+        case Isa::AVX2: distanciasAVX2(x.data(), y.data(), p, q, m, saida); break;
+        case Isa::SSE2: distanciasSSE2(x.data(), y.data(), p, q, m, saida); break;
+#endif
+        default: distanciasEscalar(x.data(), y.data(), p, q, m, saida); break;
+    }
+}
@@ -0,0 +1,40 @@
+#include "../include/Especulacao.hpp"
+#include "../include/FuncoesMain.hpp"
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+void compararEspeculacao(const TSPInstance& instancia, const ListaCandidatos* candidatos) {
+    if (Config::algoritmo != "SA")
+        throw std::runtime_error("A avaliação especulativa só está disponível para o SA!");
+
+    std::unique_ptr<SimulatedAnnealing> base = criarSolver(instancia, candidatos);
+    std::vector<int> rotaBase = base->executar();
+    std::cout << "Rota de partida: custo " << calcularCustoTotal(instancia, rotaBase)
+              << ", temperatura de medição " << Config::esp_tempMedicao << "\n";
+
+    std::cout << std::setw(14) << "Trabalhadores" << std::setw(12) << "Tempo (s)" << std::setw(16) << "Propostas/s"
+              << std::setw(12) << "Speed-up" << std::setw(14) << "Custo final" << "\n";
+
+    double vazaoBase = 0.0;
+    for (int trabalhadores : Config::esp_threads) {
+        std::unique_ptr<SimulatedAnnealing> solver = criarSolver(instancia, candidatos);
+        solver->setRotaInicial(rotaBase);
+        solver->setTemperaturaInicial(Config::esp_tempMedicao);
+        solver->setEspeculacao(trabalhadores, Config::esp_lotePorTrabalhador, 1.0);
+
+        auto inicio = std::chrono::high_resolution_clock::now();
+        std::vector<int> rota = solver->executar();
+        auto fim = std::chrono::high_resolution_clock::now();
+
+        double tempo = std::chrono::duration<double>(fim - inicio).count();
+        double propostas = solver->getMovimentosPropostos();
+        double vazao = propostas / tempo;
+        if (trabalhadores == 1) vazaoBase = vazao;
+
+        std::cout << std::setw(14) << trabalhadores << std::setw(12) << tempo << std::setw(16) << vazao;
+        if (vazaoBase > 0) std::cout << std::setw(12) << vazao / vazaoBase;
+        else std::cout << std::setw(12) << "-";
+        std::cout << std::setw(14) << calcularCustoTotal(instancia, rota) << "\n";
+    }
+}
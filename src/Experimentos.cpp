@@ -0,0 +1,283 @@
+#include "../include/Experimentos.hpp"
+#include "../include/FuncoesMain.hpp"
+#include "../include/PoolThreads.hpp"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+
+namespace {
+
+std::string aparar(const std::string& s) {
+    size_t ini = s.find_first_not_of(" \t\r");
+    if (ini == std::string::npos) return "";
+    size_t fim = s.find_last_not_of(" \t\r");
+    return s.substr(ini, fim - ini + 1);
+}
+
+// Itens separados por espaços ou vírgulas
+std::vector<std::string> separar(const std::string& s, bool virgulas = true) {
+    std::string texto = s;
+    if (virgulas) std::replace(texto.begin(), texto.end(), ',', ' ');
+    std::istringstream iss(texto);
+    std::vector<std::string> itens;
+    for (std::string item; iss >> item; ) itens.push_back(item);
+    return itens;
+}
+
+template <class T>
+std::vector<T> lista(const std::string& valor) {
+    std::vector<T> v;
+    for (const std::string& item : separar(valor)) v.push_back(static_cast<T>(std::stod(item)));
+    return v;
+}
+
+// Aplica chave=valor de um conjunto sobre os parâmetros
+void aplicarParametro(ParametrosSolver& p, const std::string& chave, const std::string& valor) {
+    if (chave == "sa_tempInicial") p.sa_tempInicial = std::stod(valor);
+    else if (chave == "sa_taxaResfriamento") p.sa_taxaResfriamento = std::stod(valor);
+    else if (chave == "sa_iterPorTemp") p.sa_iterPorTemp = std::stoi(valor);
+    else if (chave == "rotaInicial") p.rotaInicial = valor;
+    else if (chave == "sa_tempInicialConstruida") p.sa_tempInicialConstruida = std::stod(valor);
+    else if (chave == "buscaLocal") p.buscaLocal = valor == "1" || valor == "true";
+    else if (chave == "sa_cronograma") p.sa_cronograma = valor;
+    else if (chave == "sa_aceitacaoInicial") p.sa_aceitacaoInicial = std::stod(valor);
+    else if (chave == "sa_iterPorCidade") p.sa_iterPorCidade = std::stod(valor);
+    else if (chave == "sa_janelaParada") p.sa_janelaParada = std::stoi(valor);
+    else if (chave == "sa_aceitacaoParada") p.sa_aceitacaoParada = std::stod(valor);
+    else if (chave == "startTemp") p.startTemp = lista<double>(valor);
+    else if (chave == "endTemp") p.endTemp = lista<double>(valor);
+    else if (chave == "coolingRate") p.coolingRate = lista<double>(valor);
+    else if (chave == "maxIters") p.maxIters = lista<int>(valor);
+    else if (chave == "pt_replicas") p.pt_replicas = std::stoi(valor);
+    else if (chave == "pt_tempMin") p.pt_tempMin = std::stod(valor);
+    else if (chave == "pt_tempMax") p.pt_tempMax = std::stod(valor);
+    else if (chave == "pt_iterPorTroca") p.pt_iterPorTroca = std::stoi(valor);
+    else if (chave == "pt_trocas") p.pt_trocas = std::stoi(valor);
+    else if (chave == "pt_threads") p.pt_threads = std::stoi(valor);
+    else if (chave == "tempoLimite") p.tempoLimite = std::stod(valor);
+    else if (chave == "iteracoesLimite") p.iteracoesLimite = std::stoll(valor);
+    else if (chave == "gapAlvo") p.gapAlvo = std::stod(valor);
+    else throw std::runtime_error("Parâmetro desconhecido no manifesto: " + chave);
+}
+
+ParametrosSolver montarParametros(const ConjuntoParametros& conjunto) {
+    ParametrosSolver p;
+    for (const auto& [chave, valor] : conjunto.valores) aplicarParametro(p, chave, valor);
+    return p;
+}
+
+struct InstanciaCarregada {
+    std::string nome;
+    TSPInstance instancia;
+    std::unique_ptr<ListaCandidatos> candidatos;
+};
+
+} // namespace
+
+Manifesto lerManifesto(const std::string& arquivo) {
+    std::ifstream file(arquivo);
+    if (!file.is_open()) throw std::runtime_error("Não foi possível abrir o manifesto: " + arquivo);
+
+    namespace fs = std::filesystem;
+    fs::path base = fs::path(arquivo).parent_path();
+    auto resolver = [&base](const std::string& caminho) {
+        fs::path p(caminho);
+        return (p.is_relative() ? base / p : p).lexically_normal().string();
+    };
+
+    Manifesto m;
+    std::string linha;
+    for (int numero = 1; std::getline(file, linha); ++numero) {
+        linha = aparar(linha.substr(0, linha.find('#')));
+        if (linha.empty()) continue;
+
+        size_t igual = linha.find('=');
+        if (igual == std::string::npos)
+            throw std::runtime_error("Linha " + std::to_string(numero) + " do manifesto sem '='");
+        std::string chave = aparar(linha.substr(0, igual));
+        std::string valor = aparar(linha.substr(igual + 1));
+
+        if (chave == "instancias") {
+            for (const std::string& item : separar(valor)) {
+                std::string caminho = resolver(item);
+                if (fs::is_directory(caminho)) {
+                    std::vector<std::string> arquivos;
+                    for (const auto& entrada : fs::directory_iterator(caminho))
+                        if (entrada.path().extension() == ".tsp") arquivos.push_back(entrada.path().string());
+                    std::sort(arquivos.begin(), arquivos.end());
+                    m.instancias.insert(m.instancias.end(), arquivos.begin(), arquivos.end());
+                } else {
+                    m.instancias.push_back(caminho);
+                }
+            }
+        } else if (chave == "algoritmos") {
+            for (const std::string& a : separar(valor)) {
+                if (a != "SA" && a != "SAReaquecimento" && a != "SATrocaReplicas")
+                    throw std::runtime_error("Algoritmo inválido no manifesto: " + a);
+                m.algoritmos.push_back(a);
+            }
+        } else if (chave == "vizinhancas") {
+            for (const std::string& v : separar(valor)) {
+                tipoVizinhanca(v);
+                m.vizinhancas.push_back(v);
+            }
+        } else if (chave == "sementes") {
+            for (const std::string& item : separar(valor)) {
+                size_t traco = item.find('-');
+                if (traco == std::string::npos) {
+                    m.sementes.push_back(std::stoull(item));
+                } else {
+                    uint64_t de = std::stoull(item.substr(0, traco)), ate = std::stoull(item.substr(traco + 1));
+                    if (de > ate) throw std::runtime_error("Intervalo de sementes invertido no manifesto: " + item);
+                    for (uint64_t s = de; s <= ate; ++s) m.sementes.push_back(s);
+                }
+            }
+        } else if (chave.rfind("conjunto", 0) == 0) {
+            ConjuntoParametros c;
+            c.nome = aparar(chave.substr(8));
+            if (c.nome.empty()) throw std::runtime_error("Conjunto sem nome na linha " + std::to_string(numero));
+            for (const std::string& par : separar(valor, false)) {
+                size_t sep = par.find('=');
+                if (sep == std::string::npos)
+                    throw std::runtime_error("Parâmetro sem valor no conjunto " + c.nome + ": " + par);
+                c.valores.emplace_back(par.substr(0, sep), par.substr(sep + 1));
+            }
+            montarParametros(c);   // valida as chaves
+            m.conjuntos.push_back(std::move(c));
+        } else if (chave == "threads") {
+            m.threads = std::stoi(valor);
+        } else if (chave == "saida") {
+            m.saida = resolver(valor);
+        } else {
+            throw std::runtime_error("Chave desconhecida no manifesto: " + chave);
+        }
+    }
+
+    if (m.instancias.empty()) throw std::runtime_error("Manifesto sem instâncias");
+    if (m.algoritmos.empty()) m.algoritmos.push_back(Config::algoritmo);
+    if (m.vizinhancas.empty()) m.vizinhancas.push_back(Config::vizinhanca);
+    if (m.conjuntos.empty()) m.conjuntos.push_back({"padrao", {}});
+    if (m.sementes.empty()) m.sementes.push_back(Config::semente);
+    return m;
+}
+
+std::vector<ResultadoExperimento> executarExperimentos(const Manifesto& manifesto) {
+    // Cada instância é carregada uma única vez e compartilhada, só para leitura
+    std::vector<std::unique_ptr<InstanciaCarregada>> instancias;
+    for (const std::string& arquivo : manifesto.instancias) {
+        auto carregada = std::make_unique<InstanciaCarregada>();
+        carregada->nome = std::filesystem::path(arquivo).stem().string();
+        carregarInstancia(carregada->instancia, arquivo);
+        prepararInstancia(carregada->instancia);
+        carregada->candidatos = criarListaCandidatos(carregada->instancia);
+        carregada->instancia.saveBinaryCache();
+        instancias.push_back(std::move(carregada));
+    }
+
+    PoolThreads pool(manifesto.threads);
+
+    struct Trabalho {
+        const InstanciaCarregada* instancia;
+        ParametrosSolver parametros;
+        std::string conjunto;
+    };
+    std::vector<Trabalho> trabalhos;
+    for (const auto& inst : instancias)
+        for (const std::string& algoritmo : manifesto.algoritmos)
+            for (const std::string& vizinhanca : manifesto.vizinhancas)
+                for (const ConjuntoParametros& conjunto : manifesto.conjuntos)
+                    for (uint64_t semente : manifesto.sementes) {
+                        ParametrosSolver p = montarParametros(conjunto);
+                        p.algoritmo = algoritmo;
+                        p.vizinhanca = vizinhanca;
+                        p.semente = semente;
+                        // As réplicas ficam na thread do trabalho, sem um pool dentro do pool
+                        if (pool.size() > 1) p.pt_threads = 1;
+                        trabalhos.push_back({inst.get(), std::move(p), conjunto.nome});
+                    }
+
+    // Maiores instâncias primeiro: a fila do pool é FIFO, então a ordem de envio é a de execução
+    std::vector<size_t> ordem(trabalhos.size());
+    for (size_t t = 0; t < ordem.size(); ++t) ordem[t] = t;
+    std::stable_sort(ordem.begin(), ordem.end(), [&](size_t a, size_t b) {
+        return trabalhos[a].instancia->instancia.getDimension() > trabalhos[b].instancia->instancia.getDimension();
+    });
+
+    std::vector<ResultadoExperimento> resultados(trabalhos.size());
+    std::vector<std::exception_ptr> erros(trabalhos.size());
+    std::mutex mtxSaida;
+    size_t concluidos = 0;
+    const auto& melhoresResultados = getMelhoresResultados();
+
+    std::cout << "Experimentos: " << trabalhos.size() << " execuções de " << instancias.size()
+              << " instâncias em " << pool.size() << " threads\n";
+
+    for (size_t t : ordem) {
+        pool.enviar([&, t] {
+            try {
+                const Trabalho& trab = trabalhos[t];
+                const TSPInstance& instancia = trab.instancia->instancia;
+                std::unique_ptr<SimulatedAnnealing> solver =
+                    criarSolver(instancia, trab.instancia->candidatos.get(), trab.parametros);
+
+                auto inicio = std::chrono::high_resolution_clock::now();
+                std::vector<int> rota = solver->executar();
+                auto fim = std::chrono::high_resolution_clock::now();
+
+                ResultadoExperimento& r = resultados[t];
+                r.instancia = trab.instancia->nome;
+                r.dimensao = instancia.getDimension();
+                r.algoritmo = trab.parametros.algoritmo;
+                r.vizinhanca = trab.parametros.vizinhanca;
+                r.conjunto = trab.conjunto;
+                r.semente = trab.parametros.semente;
+                r.custo = calcularCustoTotal(instancia, rota);
+                auto otimo = melhoresResultados.find(r.instancia);
+                r.gap = otimo != melhoresResultados.end() ? calcularGap(r.custo, otimo->second) : std::nan("");
+                r.tempo = std::chrono::duration<double>(fim - inicio).count();
+                r.movimentos = solver->getMovimentosPropostos();
+
+                std::ostringstream linha;
+                linha << std::fixed << r.instancia << " " << r.algoritmo << " " << r.vizinhanca << " "
+                      << r.conjunto << " semente " << r.semente << ": custo " << std::setprecision(2) << r.custo
+                      << ", " << std::setprecision(3) << r.tempo << " s\n";
+                std::lock_guard<std::mutex> lock(mtxSaida);
+                std::cout << "[" << ++concluidos << "/" << trabalhos.size() << "] " << linha.str();
+            } catch (...) {
+                erros[t] = std::current_exception();
+            }
+        });
+    }
+    pool.aguardar();
+
+    for (const std::exception_ptr& e : erros)
+        if (e) std::rethrow_exception(e);
+    return resultados;
+}
+
+void salvarResultadosExperimentos(const std::string& arquivo, const std::vector<ResultadoExperimento>& resultados) {
+    std::ofstream file(arquivo);
+    if (!file.is_open()) {
+        std::cerr << "Erro ao abrir arquivo: " << arquivo << std::endl;
+        return;
+    }
+
+    file << std::fixed;
+    file << "Instance,Dimension,Algorithm,Neighbourhood,ParameterSet,Seed,Cost,Gap,WallTime,Moves,MovesPerSecond\n";
+    for (const ResultadoExperimento& r : resultados) {
+        file << r.instancia << "," << r.dimensao << "," << r.algoritmo << "," << r.vizinhanca << ","
+             << r.conjunto << "," << r.semente << "," << std::setprecision(2) << r.custo << ",";
+        if (!std::isnan(r.gap)) file << std::setprecision(4) << r.gap;
+        file << "," << std::setprecision(6) << r.tempo << "," << r.movimentos << ","
+             << std::setprecision(0) << (r.tempo > 0 ? r.movimentos / r.tempo : 0.0) << "\n";
+    }
+
+    std::cout << "Resultados salvos em: " << arquivo << std::endl;
+}
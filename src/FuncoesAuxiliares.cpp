@@ -1,4 +1,6 @@
 #include "../include/FuncoesAuxiliares.hpp"
+#include "../include/PoliticasDistancia.hpp"
+#include "../include/Vizinhancas.hpp"
 #include <fstream>
 #include <iostream>
 
@@ -11,30 +13,28 @@ double calcularCusto(const std::vector<int>& rota, const TSPInstance& instance)
     return custo;
 }
 
-std::vector<int> gerarRotaInicial(const TSPInstance& instance) {
+std::vector<int> gerarRotaInicial(const TSPInstance& instance, Rng& rng) {
     std::vector<int> rota(instance.getDimension());
     for (size_t i = 0; i < rota.size(); ++i) rota[i] = i;
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(rota.begin(), rota.end(), g);
+    std::shuffle(rota.begin(), rota.end(), rng);
     return rota;
 }
 
 
-std::vector<int> gerarVizinhaSwap(const std::vector<int>& rota) {
+std::vector<int> gerarVizinhaSwap(const std::vector<int>& rota, Rng& rng) {
     std::vector<int> nova = rota;
-    size_t i = rand() % rota.size();
-    size_t j = rand() % rota.size();
-    while (i == j) j = rand() % rota.size();
+    size_t i = rng.inteiro(rota.size());
+    size_t j = rng.inteiro(rota.size());
+    while (i == j) j = rng.inteiro(rota.size());
     std::swap(nova[i], nova[j]);
     return nova;
 }
 
-std::vector<int> gerarVizinhaInsertion(const std::vector<int>& rota) {
+std::vector<int> gerarVizinhaInsertion(const std::vector<int>& rota, Rng& rng) {
     std::vector<int> nova = rota;
-    size_t i = rand() % rota.size();
-    size_t j = rand() % rota.size();
-    while (i == j) j = rand() % rota.size();
+    size_t i = rng.inteiro(rota.size());
+    size_t j = rng.inteiro(rota.size());
+    while (i == j) j = rng.inteiro(rota.size());
 
     int cidade = nova[i];
     nova.erase(nova.begin() + i);
@@ -44,105 +44,107 @@ std::vector<int> gerarVizinhaInsertion(const std::vector<int>& rota) {
 
 
 
-double calcularDeltaInsertion(const std::vector<int>& rota, int pos_remover, int pos_inserir, const TSPInstance& instance) {
-    int n = rota.size();
-    if (pos_remover == pos_inserir) return 0;
-
-    auto mod = [n](int x) { return (x + n) % n; };
-
-    int cidade = rota[pos_remover];
-    int antes_remover = rota[mod(pos_remover - 1)];
-    int depois_remover = rota[mod(pos_remover + 1)];
-
-    double custo_antes = instance.getDistance(antes_remover, cidade) +
-                         instance.getDistance(cidade, depois_remover);
-    double custo_depois = instance.getDistance(antes_remover, depois_remover);
-
-    std::vector<int> nova_rota = rota;
-    nova_rota.erase(nova_rota.begin() + pos_remover);
-    nova_rota.insert(nova_rota.begin() + pos_inserir, cidade);
-
-    int antes_inserir = nova_rota[mod(pos_inserir - 1)];
-    int depois_inserir = nova_rota[mod(pos_inserir + 1)];
-
-    double custo_antigo = instance.getDistance(antes_inserir, depois_inserir);
-    double custo_novo = instance.getDistance(antes_inserir, cidade) +
-                        instance.getDistance(cidade, depois_inserir);
+// ===== Vizinhanças sobre a instância (métrica escolhida em tempo de execução) =====
 
-    return (custo_depois - custo_antes) + (custo_novo - custo_antigo);
+double calcularDeltaInsertion(const std::vector<int>& rota, int pos_remover, int pos_inserir, const TSPInstance& instance) {
+    return calcularDeltaInsertion(rota, pos_remover, pos_inserir, DistanciaInstancia(instance));
 }
 
-std::pair<std::vector<int>, double> gerarVizinhaInsertionComDelta(const std::vector<int>& rota, double custoAtual, const TSPInstance& instance) {
-    int n = rota.size();
-    if (n <= 1) return {rota, 0.0};
-
-    int pos_remover = rand() % n;
-    int pos_inserir = rand() % (n - 1);
-    while (pos_inserir == pos_remover) {
-        pos_inserir = rand() % (n - 1);
-    }
-
-    double delta = calcularDeltaInsertion(rota, pos_remover, pos_inserir, instance);
-
-    std::vector<int> nova_rota = rota;
-    int cidade = nova_rota[pos_remover];
-    nova_rota.erase(nova_rota.begin() + pos_remover);
-    nova_rota.insert(nova_rota.begin() + pos_inserir, cidade);
-
-    return {nova_rota, delta};
+Movimento gerarVizinhaInsertionComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaInsertionComDelta(rota, DistanciaInstancia(instance), rng);
 }
 
 double calcularDeltaSwap(const std::vector<int>& rota, int i, int j, const TSPInstance& instance) {
-    int n = rota.size();
-    if (i == j) return 0.0;
-    if (i > j) std::swap(i, j);
-
-    auto mod = [n](int x) { return (x + n) % n; };
-
-    int a = rota[i];
-    int b = rota[j];
-
-    int a_ant = rota[mod(i - 1)];
-    int a_prox = rota[mod(i + 1)];
-    int b_ant = rota[mod(j - 1)];
-    int b_prox = rota[mod(j + 1)];
+    return calcularDeltaSwap(rota, i, j, DistanciaInstancia(instance));
+}
 
-    double custoAntes = 0.0;
-    double custoDepois = 0.0;
+Movimento gerarVizinhaSwapComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaSwapComDelta(rota, DistanciaInstancia(instance), rng);
+}
 
-    if (i + 1 == j) {
-        custoAntes += instance.getDistance(a_ant, a) + instance.getDistance(b, b_prox);
-        custoAntes += instance.getDistance(a, b);
+double calcularDelta2opt(const std::vector<int>& rota, int i, int j, const TSPInstance& instance) {
+    return calcularDelta2opt(rota, i, j, DistanciaInstancia(instance));
+}
 
-        custoDepois += instance.getDistance(a_ant, b) + instance.getDistance(a, b_prox);
-        custoDepois += instance.getDistance(b, a);
-    } else {
-        custoAntes += instance.getDistance(a_ant, a) + instance.getDistance(a, a_prox);
-        custoAntes += instance.getDistance(b_ant, b) + instance.getDistance(b, b_prox);
+Movimento gerarVizinha2optComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinha2optComDelta(rota, DistanciaInstancia(instance), rng);
+}
 
-        custoDepois += instance.getDistance(a_ant, b) + instance.getDistance(b, a_prox);
-        custoDepois += instance.getDistance(b_ant, a) + instance.getDistance(a, b_prox);
-    }
+double calcularDeltaOrOpt(const std::vector<int>& rota, int i, int k, int j, bool invertido, const TSPInstance& instance) {
+    return calcularDeltaOrOpt(rota, i, k, j, invertido, DistanciaInstancia(instance));
+}
 
-    return custoDepois - custoAntes;
+Movimento gerarVizinhaOrOptComDelta(const std::vector<int>& rota, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaOrOptComDelta(rota, DistanciaInstancia(instance), rng);
 }
 
-std::pair<std::vector<int>, double> gerarVizinhaSwapComDelta(const std::vector<int>& rota, double custoAtual, const TSPInstance& instance) {
-    int n = rota.size();
-    if (n <= 1) return {rota, 0.0};
+Movimento gerarVizinhaSwapCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaSwapCandidatos(rota, candidatos, DistanciaInstancia(instance), rng);
+}
 
-    int i = rand() % n;
-    int j = rand() % n;
-    while (i == j) j = rand() % n;
+Movimento gerarVizinhaInsertionCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaInsertionCandidatos(rota, candidatos, DistanciaInstancia(instance), rng);
+}
 
-    double delta = calcularDeltaSwap(rota, i, j, instance);
+Movimento gerarVizinha2optCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinha2optCandidatos(rota, candidatos, DistanciaInstancia(instance), rng);
+}
 
-    std::vector<int> nova_rota = rota;
-    std::swap(nova_rota[i], nova_rota[j]);
+Movimento gerarVizinhaOrOptCandidatos(const Rota& rota, const ListaCandidatos& candidatos, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaOrOptCandidatos(rota, candidatos, DistanciaInstancia(instance), rng);
+}
 
-    return {nova_rota, delta};
+Movimento gerarVizinhaDuasCamadas(const RotaDuasCamadas& rota, TipoMovimento tipo,
+                                  const ListaCandidatos* candidatos, const TSPInstance& instance, Rng& rng) {
+    return gerarVizinhaDuasCamadas(rota, tipo, candidatos, DistanciaInstancia(instance), rng);
 }
 
+void aplicarMovimento(std::vector<int>& rota, const Movimento& mov) {
+    switch (mov.tipo) {
+        case TipoMovimento::Swap:
+            std::swap(rota[mov.i], rota[mov.j]);
+            break;
+        case TipoMovimento::Insertion:
+            // Equivale a erase(i) + insert(j), deslocando só o trecho entre as posições
+            if (mov.i < mov.j)
+                std::rotate(rota.begin() + mov.i, rota.begin() + mov.i + 1, rota.begin() + mov.j + 1);
+            else if (mov.j < mov.i)
+                std::rotate(rota.begin() + mov.j, rota.begin() + mov.i, rota.begin() + mov.i + 1);
+            break;
+        case TipoMovimento::TwoOpt: {
+            // Inverter o complemento gera o mesmo ciclo; inverte-se o lado mais curto
+            int n = rota.size();
+            int dentro = mov.j - mov.i;
+            if (dentro <= n - dentro) {
+                std::reverse(rota.begin() + mov.i + 1, rota.begin() + mov.j + 1);
+            } else {
+                int l = (mov.j + 1) % n;
+                int r = mov.i;
+                for (int t = 0; t < (n - dentro) / 2; ++t) {
+                    std::swap(rota[l], rota[r]);
+                    l = (l + 1) % n;
+                    r = (r - 1 + n) % n;
+                }
+            }
+            break;
+        }
+        case TipoMovimento::OrOpt: {
+            int inicio;
+            if (mov.j > mov.i) {
+                std::rotate(rota.begin() + mov.i, rota.begin() + mov.i + mov.k, rota.begin() + mov.j + 1);
+                inicio = mov.j - mov.k + 1;
+            } else {
+                std::rotate(rota.begin() + mov.j + 1, rota.begin() + mov.i, rota.begin() + mov.i + mov.k);
+                inicio = mov.j + 1;
+            }
+            if (mov.invertido)
+                std::reverse(rota.begin() + inicio, rota.begin() + inicio + mov.k);
+            break;
+        }
+        default:
+            break;
+    }
+}
 
 double calcularCustoTotal(const TSPInstance& instance, const std::vector<int>& rota) {
     double custo = 0.0;
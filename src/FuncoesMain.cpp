@@ -3,46 +3,288 @@
 #include <fstream>
 #include <filesystem>
 #include <chrono>
+#include <iomanip>
+#include <sstream>
+
+// ===== Preparação da instância =====
+void carregarInstancia(TSPInstance& instancia, const std::string& arquivo) {
+    if (Config::cacheInstancias) instancia.enableBinaryCache(Config::cacheDiretorio);
+    instancia.loadFromFile(arquivo);
+}
+
+void prepararInstancia(TSPInstance& instancia) {
+    using Tipo = TSPInstance::DistanceMatrixType;
+    if (Config::matrizDistancias == "Nenhuma" || instancia.getDimension() > Config::matrizDistanciasMaxDim)
+        return;
+
+    if (Config::matrizDistancias == "INT32")
+        instancia.buildDistanceMatrix(Tipo::INT32);
+    else if (Config::matrizDistancias == "FLOAT32")
+        instancia.buildDistanceMatrix(Tipo::FLOAT32);
+    else
+        throw std::runtime_error("Tipo de matriz de distâncias inválido!");
+}
+
+// ===== Lista de candidatos =====
+std::unique_ptr<ListaCandidatos> criarListaCandidatos(TSPInstance& instancia) {
+    if (!Config::usarListaCandidatos) return nullptr;
+
+    auto inicio = std::chrono::high_resolution_clock::now();
+    auto candidatos = std::make_unique<ListaCandidatos>(instancia, Config::candidatosK);
+    auto fim = std::chrono::high_resolution_clock::now();
+    instancia.setNeighbourLists(candidatos->getK(), candidatos->getVizinhos());
+
+    std::cout << "Lista de candidatos (k = " << candidatos->getK() << ") construída em "
+              << std::chrono::duration<double>(fim - inicio).count() << " segundos\n";
+    return candidatos;
+}
 
 // ===== Vizinhanca e execução já estavam aqui =====
-SA::VizinhancaFunc escolherVizinhanca() {
-    if (Config::vizinhanca == "Insertion")
-        return gerarVizinhaInsertionComDelta;
-    else if (Config::vizinhanca == "Swap")
-        return gerarVizinhaSwapComDelta;
+SA::VizinhancaFunc escolherVizinhanca(const ListaCandidatos* candidatos, const std::string& vizinhanca) {
+    if (candidatos) {
+        const ListaCandidatos& lista = *candidatos;
+        if (vizinhanca == "Insertion")
+            return [&lista](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinhaInsertionCandidatos(r, lista, inst, rng); };
+        else if (vizinhanca == "Swap")
+            return [&lista](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinhaSwapCandidatos(r, lista, inst, rng); };
+        else if (vizinhanca == "2-opt")
+            return [&lista](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinha2optCandidatos(r, lista, inst, rng); };
+        else if (vizinhanca == "Or-opt")
+            return [&lista](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinhaOrOptCandidatos(r, lista, inst, rng); };
+        else
+            throw std::runtime_error("Vizinhança inválida!");
+    }
+
+    if (vizinhanca == "Insertion")
+        return [](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinhaInsertionComDelta(r.getCidades(), inst, rng); };
+    else if (vizinhanca == "Swap")
+        return [](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinhaSwapComDelta(r.getCidades(), inst, rng); };
+    else if (vizinhanca == "2-opt")
+        return [](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinha2optComDelta(r.getCidades(), inst, rng); };
+    else if (vizinhanca == "Or-opt")
+        return [](const Rota& r, const TSPInstance& inst, Rng& rng) { return gerarVizinhaOrOptComDelta(r.getCidades(), inst, rng); };
     else
         throw std::runtime_error("Vizinhança inválida!");
 }
 
-std::pair<std::vector<int>, std::vector<GraphData>> executarAlgoritmo(
-    const TSPInstance& instancia, SA::VizinhancaFunc vizFunc) 
+TipoMovimento tipoVizinhanca(const std::string& nome) {
+    if (nome == "Insertion") return TipoMovimento::Insertion;
+    else if (nome == "Swap") return TipoMovimento::Swap;
+    else if (nome == "2-opt") return TipoMovimento::TwoOpt;
+    else if (nome == "Or-opt") return TipoMovimento::OrOpt;
+    else throw std::runtime_error("Vizinhança inválida!");
+}
+
+SA::VizinhancaDuasCamadasFunc escolherVizinhancaDuasCamadas(const ListaCandidatos* candidatos,
+                                                            const std::string& vizinhanca) {
+    TipoMovimento tipo = tipoVizinhanca(vizinhanca);
+    return [tipo, candidatos](const RotaDuasCamadas& r, const TSPInstance& inst, Rng& rng) {
+        return gerarVizinhaDuasCamadas(r, tipo, candidatos, inst, rng);
+    };
+}
+
+static ModoPropostas modoPropostas(const std::string& nome) {
+    if (nome == "Sequencial") return ModoPropostas::Sequencial;
+    else if (nome == "MelhorDoLote") return ModoPropostas::MelhorDoLote;
+    else if (nome == "PrimeiraAceitavel") return ModoPropostas::PrimeiraAceitavel;
+    else throw std::runtime_error("Modo de propostas inválido!");
+}
+
+// ===== Criação do solver =====
+static void configurarSolver(SimulatedAnnealing& solver, const TSPInstance& instancia,
+                             const ListaCandidatos* candidatos, const ParametrosSolver& p) {
+    solver.setLimiarDuasCamadas(Config::limiarRotaDuasCamadas);
+    solver.setSemente(p.semente);
+    solver.setEspeculacao(Config::esp_trabalhadores, Config::esp_lotePorTrabalhador, Config::esp_limiarAceitacao);
+    // As propostas em lote sorteiam pares uniformes: com lista de candidatos ficam no sequencial
+    solver.setPropostasEmLote(candidatos ? ModoPropostas::Sequencial : modoPropostas(Config::modoPropostas),
+                              tipoVizinhanca(p.vizinhanca), Config::tamLotePropostas);
+
+    CronogramaAdaptativo adaptativo;
+    adaptativo.aceitacaoInicial = p.sa_aceitacaoInicial;
+    adaptativo.iterPorCidade = p.sa_iterPorCidade;
+    adaptativo.janelaNiveis = p.sa_janelaParada;
+    adaptativo.aceitacaoParada = p.sa_aceitacaoParada;
+    solver.setCronograma(tipoCronograma(p.sa_cronograma), adaptativo);
+
+    TipoRotaInicial construcao = tipoRotaInicial(p.rotaInicial);
+    solver.setConstrucaoInicial(construcao, candidatos);
+    if (construcao != TipoRotaInicial::Aleatoria && p.sa_tempInicialConstruida > 0)
+        solver.setTemperaturaInicial(p.sa_tempInicialConstruida);
+    solver.setBuscaLocal(p.buscaLocal, candidatos);
+
+    ControleExecucao controle;
+    controle.tempoLimite = p.tempoLimite;
+    controle.iteracoesLimite = p.iteracoesLimite;
+    auto otimo = getMelhoresResultados().find(instancia.getName());
+    if (p.gapAlvo >= 0 && otimo != getMelhoresResultados().end())
+        controle.custoAlvo = otimo->second * (1.0 + p.gapAlvo / 100.0);
+    solver.setControle(std::move(controle));
+}
+
+std::unique_ptr<SimulatedAnnealing> criarSolverGenerico(
+    const TSPInstance& instancia, SA::VizinhancaFunc vizFunc,
+    SA::VizinhancaDuasCamadasFunc vizDuasCamadas, const ParametrosSolver& p, const ListaCandidatos* candidatos)
 {
-    std::vector<int> melhorRota;
-    std::vector<GraphData> graphData;
+    std::unique_ptr<SimulatedAnnealing> solver;
+    if (p.algoritmo == "SA")
+        solver = std::make_unique<SA>(instancia, p.sa_tempInicial, p.sa_taxaResfriamento,
+                                      p.sa_iterPorTemp, vizFunc, vizDuasCamadas);
+    else if (p.algoritmo == "SAReaquecimento")
+        solver = std::make_unique<SAReaquecimento>(instancia, p.startTemp, p.endTemp,
+                                                   p.coolingRate, p.maxIters, vizFunc, vizDuasCamadas);
+    else if (p.algoritmo == "SATrocaReplicas")
+        solver = std::make_unique<SATrocaReplicas>(instancia, p.pt_replicas, p.pt_tempMin, p.pt_tempMax,
+                                                   p.pt_iterPorTroca, p.pt_trocas, p.pt_threads,
+                                                   vizFunc, vizDuasCamadas);
+    else
+        throw std::runtime_error("Algoritmo inválido em Config.hpp!");
 
-    auto inicio = std::chrono::high_resolution_clock::now();
+    configurarSolver(*solver, instancia, candidatos, p);
+    return solver;
+}
 
-    if (Config::algoritmo == "SA") {
-        SA sa(instancia, Config::sa_tempInicial, Config::sa_taxaResfriamento,
-              Config::sa_iterPorTemp, vizFunc);
-        melhorRota = sa.executar();
-        graphData = sa.getGraphData();
-    } 
-    else if (Config::algoritmo == "SAReaquecimento") {
-        SAReaquecimento saR(instancia, Config::startTemp, Config::endTemp,
-                            Config::coolingRate, Config::maxIters, vizFunc);
-        melhorRota = saR.executar();
-        graphData = saR.getGraphData();
-    } 
-    else {
+template <class Dist, TipoMovimento Tipo>
+static std::unique_ptr<SimulatedAnnealing> criarNucleo(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                                                       const ParametrosSolver& p) {
+    if (p.algoritmo == "SA")
+        return std::make_unique<SAEspecializado<Dist, Tipo>>(
+            instancia, p.sa_tempInicial, p.sa_taxaResfriamento, p.sa_iterPorTemp, candidatos);
+    else if (p.algoritmo == "SAReaquecimento")
+        return std::make_unique<SAReaquecimentoEspecializado<Dist, Tipo>>(
+            instancia, p.startTemp, p.endTemp, p.coolingRate, p.maxIters, candidatos);
+    else if (p.algoritmo == "SATrocaReplicas")
+        return std::make_unique<SATrocaReplicasEspecializado<Dist, Tipo>>(
+            instancia, p.pt_replicas, p.pt_tempMin, p.pt_tempMax,
+            p.pt_iterPorTroca, p.pt_trocas, p.pt_threads, candidatos);
+    else
         throw std::runtime_error("Algoritmo inválido em Config.hpp!");
+}
+
+template <class Dist>
+static std::unique_ptr<SimulatedAnnealing> criarNucleo(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                                                       const ParametrosSolver& p) {
+    switch (tipoVizinhanca(p.vizinhanca)) {
+        case TipoMovimento::Swap:      return criarNucleo<Dist, TipoMovimento::Swap>(instancia, candidatos, p);
+        case TipoMovimento::Insertion: return criarNucleo<Dist, TipoMovimento::Insertion>(instancia, candidatos, p);
+        case TipoMovimento::TwoOpt:    return criarNucleo<Dist, TipoMovimento::TwoOpt>(instancia, candidatos, p);
+        default:                       return criarNucleo<Dist, TipoMovimento::OrOpt>(instancia, candidatos, p);
     }
+}
+
+std::unique_ptr<SimulatedAnnealing> criarSolverEspecializado(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                                                             const ParametrosSolver& p) {
+    using Matriz = TSPInstance::DistanceMatrixType;
+    using Metrica = TSPInstance::EdgeWeightType;
+
+    // Mesma precedência de getDistanceFast: matriz pré-calculada, depois a métrica
+    std::unique_ptr<SimulatedAnnealing> solver;
+    if (instancia.getDistanceMatrixType() == Matriz::INT32)
+        solver = criarNucleo<DistanciaMatriz<int32_t>>(instancia, candidatos, p);
+    else if (instancia.getDistanceMatrixType() == Matriz::FLOAT32)
+        solver = criarNucleo<DistanciaMatriz<float>>(instancia, candidatos, p);
+    else if (instancia.getEdgeWeightType() == Metrica::EUC_2D)
+        solver = criarNucleo<DistanciaEuc2D>(instancia, candidatos, p);
+    else if (instancia.getEdgeWeightType() == Metrica::GEO)
+        solver = criarNucleo<DistanciaGeo>(instancia, candidatos, p);
+    else if (instancia.getEdgeWeightType() == Metrica::ATT)
+        solver = criarNucleo<DistanciaAtt>(instancia, candidatos, p);
+    else if (instancia.getEdgeWeightType() == Metrica::EXPLICIT && instancia.isEdgeWeightsPacked())
+        solver = criarNucleo<DistanciaExplicitaEmpacotada>(instancia, candidatos, p);
+    else if (instancia.getEdgeWeightType() == Metrica::EXPLICIT)
+        solver = criarNucleo<DistanciaExplicitaCheia>(instancia, candidatos, p);
+    else
+        solver = criarNucleo<DistanciaInstancia>(instancia, candidatos, p);
+
+    configurarSolver(*solver, instancia, candidatos, p);
+    return solver;
+}
 
+std::unique_ptr<SimulatedAnnealing> criarSolver(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                                                const ParametrosSolver& p) {
+    if (Config::nucleoEspecializado)
+        return criarSolverEspecializado(instancia, candidatos, p);
+    return criarSolverGenerico(instancia, escolherVizinhanca(candidatos, p.vizinhanca),
+                               escolherVizinhancaDuasCamadas(candidatos, p.vizinhanca), p, candidatos);
+}
+
+std::vector<int> executarAlgoritmo(SimulatedAnnealing& solver) {
+    auto inicio = std::chrono::high_resolution_clock::now();
+    std::vector<int> melhorRota = solver.executar();
     auto fim = std::chrono::high_resolution_clock::now();
+
     double tempoExec = std::chrono::duration<double>(fim - inicio).count();
     std::cout << "Tempo de execução: " << tempoExec << " segundos\n";
 
-    return {melhorRota, graphData};
+    return melhorRota;
+}
+
+std::shared_ptr<GravadorRastro> criarRastro(const std::string& base, long long continuarDe) {
+    FormatoRastro formato = formatoRastro(Config::rastro_formato);
+    DecimacaoRastro decimacao{Config::rastro_aCadaNiveis, Config::rastro_soMelhora};
+    return std::make_shared<GravadorRastro>(base + (formato == FormatoRastro::CSV ? ".csv" : ".bin"),
+                                            formato, decimacao, 1024, continuarDe);
+}
+
+// Parâmetros guardados no ponto de controle, um "chave=valor" por linha (ver EstadoExecucao)
+static std::string descreverConfiguracao(const ParametrosSolver& p) {
+    std::ostringstream out;
+    out << std::setprecision(17);
+    auto lista = [&](const char* chave, const auto& valores) {
+        out << chave << "=";
+        for (size_t i = 0; i < valores.size(); ++i) out << (i ? " " : "") << valores[i];
+        out << "\n";
+    };
+    out << "semente=" << p.semente << "\n"
+        << "vizinhanca=" << p.vizinhanca << "\n"
+        << "matrizDistancias=" << Config::matrizDistancias << "\n"
+        << "matrizDistanciasMaxDim=" << Config::matrizDistanciasMaxDim << "\n"
+        << "usarListaCandidatos=" << Config::usarListaCandidatos << "\n"
+        << "candidatosK=" << Config::candidatosK << "\n"
+        << "modoPropostas=" << Config::modoPropostas << "\n"
+        << "tamLotePropostas=" << Config::tamLotePropostas << "\n"
+        << "esp_trabalhadores=" << Config::esp_trabalhadores << "\n"
+        << "esp_lotePorTrabalhador=" << Config::esp_lotePorTrabalhador << "\n"
+        << "esp_limiarAceitacao=" << Config::esp_limiarAceitacao << "\n"
+        << "limiarRotaDuasCamadas=" << Config::limiarRotaDuasCamadas << "\n"
+        << "nucleoEspecializado=" << Config::nucleoEspecializado << "\n"
+        << "sa_tempInicial=" << p.sa_tempInicial << "\n"
+        << "sa_taxaResfriamento=" << p.sa_taxaResfriamento << "\n"
+        << "sa_iterPorTemp=" << p.sa_iterPorTemp << "\n"
+        << "rotaInicial=" << p.rotaInicial << "\n"
+        << "sa_tempInicialConstruida=" << p.sa_tempInicialConstruida << "\n"
+        << "buscaLocal=" << p.buscaLocal << "\n"
+        << "sa_cronograma=" << p.sa_cronograma << "\n"
+        << "sa_aceitacaoInicial=" << p.sa_aceitacaoInicial << "\n"
+        << "sa_iterPorCidade=" << p.sa_iterPorCidade << "\n"
+        << "sa_janelaParada=" << p.sa_janelaParada << "\n"
+        << "sa_aceitacaoParada=" << p.sa_aceitacaoParada << "\n";
+    lista("startTemp", p.startTemp);
+    lista("endTemp", p.endTemp);
+    lista("coolingRate", p.coolingRate);
+    lista("maxIters", p.maxIters);
+    out << "tempoLimite=" << p.tempoLimite << "\n"
+        << "iteracoesLimite=" << p.iteracoesLimite << "\n"
+        << "gapAlvo=" << p.gapAlvo << "\n";
+    return out.str();
+}
+
+long long configurarPontoControle(SimulatedAnnealing& solver) {
+    if (Config::pontoControle.empty()) return -1;
+    if (Config::algoritmo != "SA" && Config::algoritmo != "SAReaquecimento") {
+        std::cout << "Pontos de controle só no SA e no SAReaquecimento; ignorados\n";
+        return -1;
+    }
+    solver.setPontoControle(Config::pontoControle, Config::pontoControleIntervalo,
+                            descreverConfiguracao(ParametrosSolver()));
+    if (!Config::retomar || !std::filesystem::exists(Config::pontoControle)) return -1;
+
+    EstadoExecucao estado = lerPontoControle(Config::pontoControle);
+    std::cout << "Retomando de " << Config::pontoControle << ": nível " << estado.niveisRegistrados
+              << ", melhor custo " << estado.melhorCusto << "\n";
+    long long linhaRastro = estado.posicaoRastro;
+    solver.setRetomada(std::move(estado));
+    return linhaRastro;
 }
 
 // ===== Exibir resultados =====
@@ -78,12 +320,21 @@ void salvarCSV(const std::string& filename, const std::vector<GraphData>& dados)
 
     std::cout << "Salvando " << dados.size() << " linhas no CSV..." << std::endl;
 
-    file << "Iteration,Temperature,Cost,BestCost\n";
+    file << "Iteration,Temperature,Cost,BestCost,Rung,AcceptanceRate,SwapRate,"
+            "Proposals,AcceptedUphill,AcceptedDownhill,NewBest,LevelNs\n";
     for (const auto& d : dados) {
         file << d.iteration << ","
              << d.temperature << ","
              << d.cost << ","
-             << d.best_cost << "\n";
+             << d.best_cost << ","
+             << d.rung << ","
+             << d.acceptance_rate << ","
+             << d.swap_rate << ","
+             << d.proposals << ","
+             << d.accepted_uphill << ","
+             << d.accepted_downhill << ","
+             << d.new_best << ","
+             << d.level_ns << "\n";
     }
 
     file.close();
@@ -0,0 +1,153 @@
+#include "../include/Ilhas.hpp"
+#include "../include/FuncoesMain.hpp"
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <thread>
+
+namespace {
+
+// Caixa de correio de uma ilha: guarda só a rota mais recente. Enviar troca o ponteiro e
+// descarta a rota não lida; receber o retira. Cada rota tem um único dono em todo momento.
+class CaixaMigracao {
+private:
+    struct Envio {
+        std::vector<int> rota;
+        double custo;
+    };
+    std::atomic<Envio*> caixa{nullptr};
+
+public:
+    ~CaixaMigracao() { delete caixa.load(); }
+
+    void enviar(const std::vector<int>& rota, double custo) {
+        delete caixa.exchange(new Envio{rota, custo}, std::memory_order_acq_rel);
+    }
+
+    bool receber(std::vector<int>& rota, double& custo) {
+        std::unique_ptr<Envio> envio(caixa.exchange(nullptr, std::memory_order_acq_rel));
+        if (!envio) return false;
+        rota = std::move(envio->rota);
+        custo = envio->custo;
+        return true;
+    }
+};
+
+}
+
+ResultadoIlhas executarIlhas(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                             int numIlhas, int intervaloMigracao, double custoAlvo, uint64_t sementeBase) {
+    std::vector<CaixaMigracao> caixas(numIlhas);
+    std::vector<std::unique_ptr<SimulatedAnnealing>> solvers(numIlhas);
+    std::vector<std::vector<int>> rotas(numIlhas);
+    std::vector<std::exception_ptr> erros(numIlhas);
+
+    // Instante (ns desde o início) em que a primeira ilha atingiu o alvo
+    std::atomic<long long> nsAteAlvo{std::numeric_limits<long long>::max()};
+
+    for (int i = 0; i < numIlhas; ++i) {
+        solvers[i] = criarSolver(instancia, candidatos);
+        solvers[i]->setSemente(sementeBase + i);
+    }
+
+    auto inicio = std::chrono::steady_clock::now();
+    auto registrarAlvo = [&](double custo) {
+        if (custo > custoAlvo) return;
+        long long ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - inicio).count();
+        long long atual = nsAteAlvo.load();
+        while (ns < atual && !nsAteAlvo.compare_exchange_weak(atual, ns)) {}
+    };
+
+    for (int i = 0; i < numIlhas; ++i) {
+        // Alvo conferido ao fim de cada nível (rodada, na troca de réplicas), não só nas migrações;
+        // só o custo, sem cópia da rota
+        solvers[i]->setProgressoCusto([&registrarAlvo](double melhorCusto, const GraphData&) {
+            registrarAlvo(melhorCusto);
+        });
+
+        CaixaMigracao& minha = caixas[i];
+        CaixaMigracao& proxima = caixas[(i + 1) % numIlhas];
+        bool sozinha = numIlhas == 1;
+        solvers[i]->setMigracao(intervaloMigracao,
+            [&minha, &proxima, sozinha](const std::vector<int>& melhorRota, double melhorCusto,
+                                        std::vector<int>& recebida, double& custoRecebido) {
+                if (sozinha) return false;
+                proxima.enviar(melhorRota, melhorCusto);
+                return minha.receber(recebida, custoRecebido);
+            });
+    }
+
+    std::vector<std::thread> threads;
+    threads.reserve(numIlhas);
+    for (int i = 0; i < numIlhas; ++i) {
+        threads.emplace_back([&, i] {
+            try {
+                rotas[i] = solvers[i]->executar();
+            } catch (...) {
+                erros[i] = std::current_exception();
+            }
+        });
+    }
+    for (std::thread& t : threads) t.join();
+    auto fim = std::chrono::steady_clock::now();
+
+    for (const std::exception_ptr& e : erros)
+        if (e) std::rethrow_exception(e);
+
+    ResultadoIlhas resultado;
+    resultado.numIlhas = numIlhas;
+    resultado.melhorCusto = std::numeric_limits<double>::infinity();
+    for (int i = 0; i < numIlhas; ++i) {
+        double custo = calcularCustoTotal(instancia, rotas[i]);
+        registrarAlvo(custo);
+        if (custo < resultado.melhorCusto) {
+            resultado.melhorCusto = custo;
+            resultado.melhorRota = rotas[i];
+            resultado.graphData = solvers[i]->getGraphData();
+        }
+    }
+    resultado.tempoTotal = std::chrono::duration<double>(fim - inicio).count();
+    long long ns = nsAteAlvo.load();
+    resultado.tempoAteAlvo = ns == std::numeric_limits<long long>::max() ? -1.0 : ns * 1e-9;
+    return resultado;
+}
+
+ResultadoIlhas compararIlhas(const TSPInstance& instancia, const ListaCandidatos* candidatos) {
+    std::string nomeInstancia = std::filesystem::path(Config::instanciaFile).stem().string();
+    auto& melhoresResultados = getMelhoresResultados();
+    double custoAlvo = -std::numeric_limits<double>::infinity();
+    if (melhoresResultados.count(nomeInstancia))
+        custoAlvo = melhoresResultados.at(nomeInstancia) * (1.0 + Config::ilhas_gapAlvo / 100.0);
+    else
+        std::cout << "Ótimo da instância não disponível: tempo até o alvo não será medido.\n";
+
+    std::cout << "Modelo de ilhas, migração a cada " << Config::ilhas_intervaloMigracao
+              << " níveis, alvo: gap <= " << Config::ilhas_gapAlvo << "%\n";
+    std::cout << std::setw(8) << "Threads" << std::setw(14) << "Melhor custo" << std::setw(12) << "Tempo (s)"
+              << std::setw(16) << "Até o alvo (s)" << std::setw(12) << "Speed-up" << "\n";
+
+    ResultadoIlhas melhor;
+    double tempoBase = -1.0;
+    for (size_t t = 0; t < Config::ilhas_threads.size(); ++t) {
+        int numIlhas = Config::ilhas_threads[t];
+        ResultadoIlhas r = executarIlhas(instancia, candidatos, numIlhas, Config::ilhas_intervaloMigracao,
+                                         custoAlvo, Config::semente);
+        // A referência é a cadeia única (uma ilha, sem migração)
+        if (numIlhas == 1) tempoBase = r.tempoAteAlvo;
+
+        std::cout << std::setw(8) << numIlhas << std::setw(14) << r.melhorCusto << std::setw(12) << r.tempoTotal;
+        if (r.tempoAteAlvo >= 0) std::cout << std::setw(16) << r.tempoAteAlvo;
+        else std::cout << std::setw(16) << "-";
+        if (r.tempoAteAlvo > 0 && tempoBase > 0) std::cout << std::setw(12) << tempoBase / r.tempoAteAlvo;
+        else std::cout << std::setw(12) << "-";
+        std::cout << "\n";
+
+        if (t == 0 || r.melhorCusto < melhor.melhorCusto) melhor = std::move(r);
+    }
+    return melhor;
+}
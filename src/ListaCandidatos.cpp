@@ -0,0 +1,128 @@
+#include "../include/ListaCandidatos.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace {
+
+// k-d tree implícita sobre um vetor de índices: o nó de [lo, hi) é a mediana em (lo + hi) / 2,
+// separando por x nos níveis pares e por y nos ímpares
+class KDTree {
+private:
+    const std::vector<TSPInstance::City>& cidades;
+    std::vector<int> idx;
+
+    double coord(int cidade, int eixo) const {
+        return eixo == 0 ? cidades[cidade].x : cidades[cidade].y;
+    }
+
+    void construir(int lo, int hi, int eixo) {
+        if (hi - lo <= 1) return;
+        int meio = (lo + hi) / 2;
+        std::nth_element(idx.begin() + lo, idx.begin() + meio, idx.begin() + hi,
+                         [&](int a, int b) { return coord(a, eixo) < coord(b, eixo); });
+        construir(lo, meio, eixo ^ 1);
+        construir(meio + 1, hi, eixo ^ 1);
+    }
+
+    // heap: max-heap de (distância², cidade) com no máximo m elementos
+    void buscar(int lo, int hi, int eixo, int alvo, size_t m,
+                std::vector<std::pair<double, int>>& heap) const {
+        if (lo >= hi) return;
+        int meio = (lo + hi) / 2;
+        int c = idx[meio];
+
+        if (c != alvo) {
+            double dx = cidades[c].x - cidades[alvo].x;
+            double dy = cidades[c].y - cidades[alvo].y;
+            double d2 = dx * dx + dy * dy;
+            if (heap.size() < m) {
+                heap.push_back({d2, c});
+                std::push_heap(heap.begin(), heap.end());
+            } else if (d2 < heap.front().first) {
+                std::pop_heap(heap.begin(), heap.end());
+                heap.back() = {d2, c};
+                std::push_heap(heap.begin(), heap.end());
+            }
+        }
+
+        double diff = coord(alvo, eixo) - coord(c, eixo);
+        bool esquerdaPrimeiro = diff < 0;
+        if (esquerdaPrimeiro) buscar(lo, meio, eixo ^ 1, alvo, m, heap);
+        else buscar(meio + 1, hi, eixo ^ 1, alvo, m, heap);
+
+        if (heap.size() < m || diff * diff < heap.front().first) {
+            if (esquerdaPrimeiro) buscar(meio + 1, hi, eixo ^ 1, alvo, m, heap);
+            else buscar(lo, meio, eixo ^ 1, alvo, m, heap);
+        }
+    }
+
+public:
+    explicit KDTree(const std::vector<TSPInstance::City>& cidades)
+        : cidades(cidades), idx(cidades.size())
+    {
+        for (size_t i = 0; i < idx.size(); ++i) idx[i] = i;
+        construir(0, idx.size(), 0);
+    }
+
+    void maisProximos(int alvo, size_t m, std::vector<std::pair<double, int>>& heap) const {
+        heap.clear();
+        buscar(0, idx.size(), 0, alvo, m, heap);
+    }
+};
+
+} // namespace
+
+ListaCandidatos::ListaCandidatos(const TSPInstance& instance, int k)
+    : k(std::max(0, std::min(k, instance.getDimension() - 1))),
+      vizinhos(static_cast<size_t>(instance.getDimension()) * this->k)
+{
+    if (this->k == 0) return;
+
+    // Listas já calculadas para esta instância e matriz (cache binário)
+    const std::vector<int>* prontas = instance.getNeighbourLists(this->k);
+    if (prontas && prontas->size() == vizinhos.size()) {
+        vizinhos = *prontas;
+        return;
+    }
+
+    if (instance.getEdgeWeightType() == TSPInstance::EdgeWeightType::EXPLICIT)
+        construirExplicit(instance);
+    else
+        construirKDTree(instance);
+}
+
+void ListaCandidatos::construirKDTree(const TSPInstance& instance) {
+    int n = instance.getDimension();
+    KDTree arvore(instance.getCities());
+
+    // A árvore ordena pela distância euclidiana das coordenadas; para métricas em que essa
+    // ordem é só aproximada (GEO, MAN_2D) busca-se o dobro e reordena-se pela distância real
+    size_t m = std::min(2 * k, n - 1);
+    std::vector<std::pair<double, int>> heap;
+    heap.reserve(m);
+
+    for (int c = 0; c < n; ++c) {
+        arvore.maisProximos(c, m, heap);
+        for (auto& par : heap) par.first = instance.getDistanceFast(c, par.second);
+        std::partial_sort(heap.begin(), heap.begin() + k, heap.end());
+
+        int* destino = vizinhos.data() + static_cast<size_t>(c) * k;
+        for (int t = 0; t < k; ++t) destino[t] = heap[t].second;
+    }
+}
+
+void ListaCandidatos::construirExplicit(const TSPInstance& instance) {
+    int n = instance.getDimension();
+    std::vector<std::pair<double, int>> linha;
+    linha.reserve(n - 1);
+
+    for (int c = 0; c < n; ++c) {
+        linha.clear();
+        for (int j = 0; j < n; ++j)
+            if (j != c) linha.push_back({instance.getDistanceFast(c, j), j});
+        std::partial_sort(linha.begin(), linha.begin() + k, linha.end());
+
+        int* destino = vizinhos.data() + static_cast<size_t>(c) * k;
+        for (int t = 0; t < k; ++t) destino[t] = linha[t].second;
+    }
+}
@@ -0,0 +1,110 @@
+#include "../include/MultiStart.hpp"
+#include "../include/FuncoesMain.hpp"
+#include "../include/PoolThreads.hpp"
+#include <chrono>
+#include <cmath>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+
+std::vector<ResultadoCadeia> executarMultiStart(const TSPInstance& instancia, const ListaCandidatos* candidatos,
+                                                int numCadeias, int numThreads, uint64_t sementeBase) {
+    std::vector<ResultadoCadeia> resultados(numCadeias);
+    std::vector<std::exception_ptr> erros(numCadeias);
+
+    PoolThreads pool(numThreads);
+    std::cout << "Multi-start: " << numCadeias << " cadeias em " << pool.size() << " threads\n";
+
+    for (int c = 0; c < numCadeias; ++c) {
+        pool.enviar([&, c] {
+            try {
+                ResultadoCadeia& r = resultados[c];
+                r.semente = sementeBase + c;
+
+                std::unique_ptr<SimulatedAnnealing> solver = criarSolver(instancia, candidatos);
+                solver->setSemente(r.semente);
+
+                auto inicio = std::chrono::high_resolution_clock::now();
+                r.rota = solver->executar();
+                auto fim = std::chrono::high_resolution_clock::now();
+
+                r.tempo = std::chrono::duration<double>(fim - inicio).count();
+                r.custo = calcularCustoTotal(instancia, r.rota);
+                r.graphData = solver->getGraphData();
+            } catch (...) {
+                erros[c] = std::current_exception();
+            }
+        });
+    }
+    pool.aguardar();
+
+    for (const std::exception_ptr& e : erros)
+        if (e) std::rethrow_exception(e);
+    return resultados;
+}
+
+int melhorCadeia(const std::vector<ResultadoCadeia>& resultados) {
+    int melhor = 0;
+    for (size_t c = 1; c < resultados.size(); ++c)
+        if (resultados[c].custo < resultados[melhor].custo) melhor = c;
+    return melhor;
+}
+
+// Média e desvio padrão amostral
+static std::pair<double, double> mediaDesvio(const std::vector<double>& valores) {
+    double soma = 0.0;
+    for (double v : valores) soma += v;
+    double media = soma / valores.size();
+
+    double quadrados = 0.0;
+    for (double v : valores) quadrados += (v - media) * (v - media);
+    double desvio = valores.size() > 1 ? std::sqrt(quadrados / (valores.size() - 1)) : 0.0;
+    return {media, desvio};
+}
+
+void exibirResumoMultiStart(const std::vector<ResultadoCadeia>& resultados) {
+    if (resultados.empty()) return;
+
+    std::string nomeInstancia = std::filesystem::path(Config::instanciaFile).stem().string();
+    auto& melhoresResultados = getMelhoresResultados();
+    bool temOtimo = melhoresResultados.count(nomeInstancia) > 0;
+    double custoOtimo = temOtimo ? melhoresResultados.at(nomeInstancia) : 0.0;
+
+    std::ios estadoAnterior(nullptr);
+    estadoAnterior.copyfmt(std::cout);
+    std::cout << std::fixed;
+
+    std::vector<double> custos, gaps;
+    std::cout << "\nInstância: " << nomeInstancia << "\n";
+    std::cout << std::setw(7) << "Cadeia" << std::setw(12) << "Semente" << std::setw(14) << "Custo"
+              << std::setw(10) << "Gap (%)" << std::setw(12) << "Tempo (s)" << "\n";
+    for (size_t c = 0; c < resultados.size(); ++c) {
+        const ResultadoCadeia& r = resultados[c];
+        custos.push_back(r.custo);
+        std::cout << std::setw(7) << c << std::setw(12) << r.semente
+                  << std::setw(14) << std::setprecision(2) << r.custo;
+        if (temOtimo) {
+            gaps.push_back(calcularGap(r.custo, custoOtimo));
+            std::cout << std::setw(10) << std::setprecision(3) << gaps.back();
+        } else {
+            std::cout << std::setw(10) << "-";
+        }
+        std::cout << std::setw(12) << std::setprecision(4) << r.tempo << "\n";
+    }
+
+    std::cout << std::setprecision(2);
+    auto [mediaCusto, desvioCusto] = mediaDesvio(custos);
+    const ResultadoCadeia& melhor = resultados[melhorCadeia(resultados)];
+    std::cout << "\nCusto: melhor " << melhor.custo << ", média " << mediaCusto
+              << ", desvio padrão " << desvioCusto << "\n";
+
+    if (temOtimo) {
+        auto [mediaGap, desvioGap] = mediaDesvio(gaps);
+        std::cout << "Gap (%): melhor " << calcularGap(melhor.custo, custoOtimo) << ", média " << mediaGap
+                  << ", desvio padrão " << desvioGap << " (ótimo conhecido " << custoOtimo << ")\n";
+    } else {
+        std::cout << "Ótimo da instância não disponível.\n";
+    }
+    std::cout.copyfmt(estadoAnterior);
+}
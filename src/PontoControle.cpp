@@ -0,0 +1,195 @@
+#include "../include/PontoControle.hpp"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+const char magicPontoControle[8] = {'S', 'A', 'R', 'E', 'T', 'O', 'M', 'A'};
+const uint32_t versaoPontoControle = 3;
+
+class Escritor {
+public:
+    std::vector<char> dados;
+
+    template <class T>
+    void valor(const T& v) {
+        const char* p = reinterpret_cast<const char*>(&v);
+        dados.insert(dados.end(), p, p + sizeof(T));
+    }
+    template <class T>
+    void vetor(const std::vector<T>& v) {
+        valor(uint64_t(v.size()));
+        const char* p = reinterpret_cast<const char*>(v.data());
+        dados.insert(dados.end(), p, p + v.size() * sizeof(T));
+    }
+    void texto(const std::string& s) {
+        valor(uint64_t(s.size()));
+        dados.insert(dados.end(), s.begin(), s.end());
+    }
+};
+
+class Leitor {
+private:
+    const char* p;
+    const char* fim;
+    const std::string& caminho;
+
+    void ler(void* destino, uint64_t bytes) {
+        if (uint64_t(fim - p) < bytes) throw std::runtime_error("Ponto de controle truncado: " + caminho);
+        std::memcpy(destino, p, bytes);
+        p += bytes;
+    }
+    uint64_t tamanho(uint64_t bytesItem) {
+        uint64_t n;
+        valor(n);
+        if (n > uint64_t(fim - p) / bytesItem) throw std::runtime_error("Ponto de controle truncado: " + caminho);
+        return n;
+    }
+
+public:
+    Leitor(const std::vector<char>& dados, const std::string& caminho)
+        : p(dados.data()), fim(dados.data() + dados.size()), caminho(caminho) {}
+
+    template <class T>
+    void valor(T& v) { ler(&v, sizeof(T)); }
+    template <class T>
+    void vetor(std::vector<T>& v) {
+        v.resize(tamanho(sizeof(T)));
+        ler(v.data(), v.size() * sizeof(T));
+    }
+    void texto(std::string& s) {
+        s.resize(tamanho(1));
+        ler(s.data(), s.size());
+    }
+    bool fimDoArquivo() const { return p == fim; }
+};
+
+// Ordem dos campos no arquivo, a mesma para gravar e ler
+template <class Arquivo, class Estado>
+void campos(Arquivo& a, Estado& e) {
+    a.texto(e.algoritmo);
+    a.texto(e.instancia);
+    a.valor(e.dimensao);
+    a.texto(e.configuracao);
+    a.valor(e.fase);
+    a.valor(e.temperatura);
+    a.valor(e.iterNivel);
+    a.valor(e.iteracao);
+    a.valor(e.proximaVerificacao);
+    a.valor(e.aceitosNivel);
+    a.valor(e.custoAtual);
+    a.valor(e.melhorCusto);
+    a.valor(e.movimentosPropostos);
+    a.valor(e.niveisRegistrados);
+    a.valor(e.posicaoRastro);
+    a.vetor(e.decimacao.niveisDegrau);
+    a.vetor(e.decimacao.ultimoMelhor);
+    a.vetor(e.decimacao.descartado);
+    a.vetor(e.decimacao.temDescartado);
+    a.valor(e.segundos);
+    a.valor(e.resumo);
+    a.valor(e.rng);
+    a.vetor(e.janela);
+    a.valor(e.duasCamadas);
+    a.vetor(e.rotaAtual);
+    a.vetor(e.melhorRota);
+}
+
+}
+
+void gravarPontoControle(const std::string& caminho, const EstadoExecucao& estado) {
+    Escritor escritor;
+    escritor.dados.insert(escritor.dados.end(), std::begin(magicPontoControle), std::end(magicPontoControle));
+    escritor.valor(versaoPontoControle);
+    campos(escritor, estado);
+
+    std::string temp = caminho + ".tmp";
+    {
+        std::ofstream out(temp, std::ios::binary | std::ios::trunc);
+        if (!out) throw std::runtime_error("Erro ao abrir arquivo: " + temp);
+        out.write(escritor.dados.data(), escritor.dados.size());
+        if (!out) throw std::runtime_error("Erro ao gravar ponto de controle: " + temp);
+    }
+    std::filesystem::rename(temp, caminho);
+}
+
+EstadoExecucao lerPontoControle(const std::string& caminho) {
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in) throw std::runtime_error("Erro ao abrir arquivo: " + caminho);
+    std::vector<char> dados((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+    Leitor leitor(dados, caminho);
+    char magic[sizeof(magicPontoControle)];
+    uint32_t versao = 0;
+    leitor.valor(magic);
+    leitor.valor(versao);
+    if (std::memcmp(magic, magicPontoControle, sizeof(magic)) != 0 || versao != versaoPontoControle)
+        throw std::runtime_error("Ponto de controle incompatível: " + caminho);
+
+    EstadoExecucao estado;
+    campos(leitor, estado);
+    if (!leitor.fimDoArquivo()) throw std::runtime_error("Ponto de controle inválido: " + caminho);
+    return estado;
+}
+
+GravadorPontoControle::GravadorPontoControle(const std::string& caminho)
+    : caminho(caminho), gravador(&GravadorPontoControle::laco, this) {}
+
+GravadorPontoControle::~GravadorPontoControle() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        encerrando = true;
+    }
+    temEstado.notify_one();
+    if (gravador.joinable()) gravador.join();
+}
+
+void GravadorPontoControle::concluir() {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        pendente.reset();
+        rastro.reset();
+        encerrando = true;
+    }
+    temEstado.notify_one();
+    if (gravador.joinable()) gravador.join();
+
+    std::error_code erro;
+    std::filesystem::remove(caminho, erro);
+    std::filesystem::remove(caminho + ".tmp", erro);
+}
+
+void GravadorPontoControle::enviar(EstadoExecucao estado, std::shared_ptr<SinkRastro> destinoRastro) {
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        pendente = std::make_unique<EstadoExecucao>(std::move(estado));
+        rastro = std::move(destinoRastro);
+    }
+    temEstado.notify_one();
+}
+
+void GravadorPontoControle::laco() {
+    std::unique_lock<std::mutex> lock(mtx);
+    for (;;) {
+        temEstado.wait(lock, [&] { return pendente || encerrando; });
+        if (!pendente) break;
+
+        std::unique_ptr<EstadoExecucao> estado = std::move(pendente);
+        std::shared_ptr<SinkRastro> destinoRastro = std::move(rastro);
+        lock.unlock();
+
+        // Uma falha de gravação não interrompe a execução; o ponto anterior continua valendo
+        try {
+            if (destinoRastro) destinoRastro->aguardarGravacao(estado->posicaoRastro);
+            gravarPontoControle(caminho, *estado);
+        } catch (const std::exception& e) {
+            std::cerr << "Erro no ponto de controle: " << e.what() << std::endl;
+        }
+        lock.lock();
+    }
+}
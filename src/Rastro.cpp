@@ -0,0 +1,315 @@
+#include "../include/Rastro.hpp"
+#include <stdexcept>
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <iterator>
+#include <numeric>
+
+namespace {
+
+struct ColunaRastro {
+    const char* nome;
+    char tipo;
+};
+
+const ColunaRastro colunasRastro[] = {
+    {"Iteration", 'l'}, {"Temperature", 'd'}, {"Cost", 'd'}, {"BestCost", 'd'},
+    {"Rung", 'i'}, {"AcceptanceRate", 'd'}, {"SwapRate", 'd'},
+    {"Proposals", 'l'}, {"AcceptedUphill", 'l'}, {"AcceptedDownhill", 'l'}, {"NewBest", 'l'}, {"LevelNs", 'l'},
+};
+
+const char magicRastro[8] = {'S', 'A', 'R', 'A', 'S', 'T', 'R', 'O'};
+const uint32_t versaoRastro = 1;
+
+template <class T>
+void gravarBinario(std::ostream& out, const T& valor) {
+    out.write(reinterpret_cast<const char*>(&valor), sizeof(T));
+}
+
+template <class T>
+void lerBinario(std::istream& in, T& valor) {
+    in.read(reinterpret_cast<char*>(&valor), sizeof(T));
+}
+
+// Uma coluna do bloco: os valores de todas as linhas em sequência
+template <class T, class Campo>
+void gravarColuna(std::ofstream& out, const std::vector<GraphData>& linhas, Campo campo) {
+    std::vector<T> valores;
+    valores.reserve(linhas.size());
+    for (const GraphData& d : linhas) valores.push_back(static_cast<T>(d.*campo));
+    out.write(reinterpret_cast<const char*>(valores.data()), valores.size() * sizeof(T));
+}
+
+// Retomada: cortam o rastro existente depois de 'linhas' linhas (e de linhas incompletas) e
+// retornam quantas ficaram, menos que 'linhas' se o arquivo não as tiver
+long long cortarCSV(const std::string& caminho, long long linhas) {
+    std::ifstream in(caminho, std::ios::binary);
+    if (!in) throw std::runtime_error("Erro ao abrir arquivo: " + caminho);
+
+    std::vector<char> buffer(1 << 16);
+    long long quebras = 0;
+    uint64_t lidosAntes = 0, corte = 0;
+    while (quebras <= linhas && in) {
+        in.read(buffer.data(), buffer.size());
+        std::streamsize lidos = in.gcount();
+        for (std::streamsize i = 0; i < lidos && quebras <= linhas; ++i) {
+            if (buffer[i] != '\n') continue;
+            ++quebras;
+            corte = lidosAntes + i + 1;
+        }
+        lidosAntes += lidos;
+    }
+    in.close();
+    if (quebras == 0) throw std::runtime_error("Rastro sem cabeçalho: " + caminho);
+
+    std::filesystem::resize_file(caminho, corte);
+    return quebras - 1;
+}
+
+long long cortarBinario(const std::string& caminho, long long linhas) {
+    std::fstream f(caminho, std::ios::binary | std::ios::in | std::ios::out);
+    if (!f) throw std::runtime_error("Erro ao abrir arquivo: " + caminho);
+
+    char magic[sizeof(magicRastro)];
+    uint32_t versao = 0, colunas = 0;
+    f.read(magic, sizeof(magic));
+    lerBinario(f, versao);
+    lerBinario(f, colunas);
+    if (!f || std::memcmp(magic, magicRastro, sizeof(magic)) != 0 || versao != versaoRastro ||
+        colunas != std::size(colunasRastro))
+        throw std::runtime_error("Rastro binário incompatível: " + caminho);
+
+    std::vector<uint64_t> bytesColuna(colunas);
+    for (uint64_t& bytes : bytesColuna) {
+        char nome[15];
+        f.read(nome, sizeof(nome));
+        bytes = f.get() == 'i' ? 4 : 8;
+    }
+    const uint64_t bytesLinha = std::accumulate(bytesColuna.begin(), bytesColuna.end(), uint64_t(0));
+    const uint64_t tamanho = std::filesystem::file_size(caminho);
+
+    uint64_t inicioBloco = f.tellg();
+    long long mantidas = 0;
+    while (mantidas < linhas && inicioBloco + 8 <= tamanho) {
+        uint32_t n = 0, reservado = 0;
+        f.seekg(inicioBloco);
+        lerBinario(f, n);
+        lerBinario(f, reservado);
+        const uint64_t fimBloco = inicioBloco + 8 + n * bytesLinha;
+        if (fimBloco > tamanho) break;   // bloco incompleto
+        if (mantidas + n <= linhas) {
+            mantidas += n;
+            inicioBloco = fimBloco;
+            continue;
+        }
+
+        // O corte cai dentro do bloco: regrava as primeiras m linhas de cada coluna
+        const uint32_t m = static_cast<uint32_t>(linhas - mantidas);
+        std::vector<char> bloco(n * bytesLinha), cortado;
+        f.read(bloco.data(), bloco.size());
+        const char* coluna = bloco.data();
+        for (uint64_t bytes : bytesColuna) {
+            cortado.insert(cortado.end(), coluna, coluna + m * bytes);
+            coluna += n * bytes;
+        }
+        f.seekp(inicioBloco);
+        gravarBinario(f, m);
+        gravarBinario(f, reservado);
+        f.write(cortado.data(), cortado.size());
+        mantidas += m;
+        inicioBloco += 8 + m * bytesLinha;
+    }
+    f.close();
+
+    std::filesystem::resize_file(caminho, inicioBloco);
+    return mantidas;
+}
+
+}
+
+FormatoRastro formatoRastro(const std::string& nome) {
+    if (nome == "CSV") return FormatoRastro::CSV;
+    if (nome == "Binario") return FormatoRastro::Binario;
+    throw std::runtime_error("Formato de rastro desconhecido: " + nome);
+}
+
+GravadorRastro::GravadorRastro(const std::string& caminho, FormatoRastro formato,
+                               DecimacaoRastro decimacao, size_t capacidade, long long continuarDe)
+    : formato(formato), decimacao(decimacao), anel(capacidade > 0 ? capacidade : 1) {
+    if (this->decimacao.aCadaNiveis < 1) this->decimacao.aCadaNiveis = 1;
+
+    if (continuarDe >= 0) {
+        long long mantidas = formato == FormatoRastro::CSV ? cortarCSV(caminho, continuarDe)
+                                                           : cortarBinario(caminho, continuarDe);
+        if (mantidas < continuarDe)
+            throw std::runtime_error("Rastro com menos linhas que o ponto de controle: " + caminho);
+        aceitas = gravadas = duraveis = continuarDe;
+        arquivo.open(caminho, std::ios::binary | std::ios::app);
+    } else {
+        arquivo.open(caminho, std::ios::binary);
+    }
+    if (!arquivo.is_open()) throw std::runtime_error("Erro ao abrir arquivo: " + caminho);
+
+    // Na retomada o cabeçalho já está no arquivo
+    if (continuarDe < 0 && formato == FormatoRastro::CSV) {
+        arquivo << "Iteration,Temperature,Cost,BestCost,Rung,AcceptanceRate,SwapRate,"
+                   "Proposals,AcceptedUphill,AcceptedDownhill,NewBest,LevelNs\n";
+    } else if (continuarDe < 0) {
+        arquivo.write(magicRastro, sizeof(magicRastro));
+        gravarBinario(arquivo, versaoRastro);
+        gravarBinario(arquivo, uint32_t(std::size(colunasRastro)));
+        for (const ColunaRastro& c : colunasRastro) {
+            char nome[15] = {};
+            std::memcpy(nome, c.nome, std::min(std::strlen(c.nome), sizeof(nome)));
+            arquivo.write(nome, sizeof(nome));
+            arquivo.put(c.tipo);
+        }
+    }
+    pendentes.reserve(formato == FormatoRastro::Binario ? linhasPorBloco : anel.size());
+
+    gravador = std::thread(&GravadorRastro::laco, this);
+}
+
+GravadorRastro::~GravadorRastro() {
+    try {
+        fechar();
+    } catch (...) {
+    }
+}
+
+void GravadorRastro::registrar(const GraphData& dados) {
+    EstadoDecimacao& d = estadoDecimacao;
+    size_t r = dados.rung > 0 ? size_t(dados.rung) : 0;
+    if (r >= d.niveisDegrau.size()) {
+        d.niveisDegrau.resize(r + 1, 0);
+        d.ultimoMelhor.resize(r + 1, 0.0);
+        d.descartado.resize(r + 1);
+        d.temDescartado.resize(r + 1, 0);
+    }
+
+    long long nivel = d.niveisDegrau[r]++;
+    bool gravar = nivel % decimacao.aCadaNiveis == 0;
+    if (decimacao.soMelhora && nivel > 0) gravar = gravar && dados.best_cost != d.ultimoMelhor[r];
+
+    if (gravar) {
+        enfileirar(dados);
+        d.ultimoMelhor[r] = dados.best_cost;
+        d.temDescartado[r] = 0;
+    } else {
+        d.descartado[r] = dados;
+        d.temDescartado[r] = 1;
+    }
+}
+
+void GravadorRastro::enfileirar(const GraphData& dados) {
+    std::unique_lock<std::mutex> lock(mtx);
+    temEspaco.wait(lock, [&] { return ocupados < anel.size(); });
+    anel[(inicio + ocupados) % anel.size()] = dados;
+    ++ocupados;
+    lock.unlock();
+    temLinhas.notify_one();
+    ++aceitas;
+}
+
+void GravadorRastro::aguardarGravacao(long long linhas) {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (duraveis < linhas && !terminou) {
+        pedidoSincronizacao = true;
+        temLinhas.notify_one();
+        sincronizado.wait(lock);
+    }
+}
+
+void GravadorRastro::fechar() {
+    if (!gravador.joinable()) return;
+
+    EstadoDecimacao& d = estadoDecimacao;
+    for (size_t r = 0; r < d.descartado.size(); ++r)
+        if (d.temDescartado[r]) enfileirar(d.descartado[r]);
+    d.descartado.clear();
+    d.temDescartado.clear();
+
+    {
+        std::lock_guard<std::mutex> lock(mtx);
+        encerrando = true;
+    }
+    temLinhas.notify_one();
+    gravador.join();
+}
+
+void GravadorRastro::laco() {
+    std::unique_lock<std::mutex> lock(mtx);
+    for (;;) {
+        temLinhas.wait(lock, [&] { return ocupados > 0 || encerrando || pedidoSincronizacao; });
+        if (ocupados == 0 && encerrando) break;
+
+        while (ocupados > 0) {
+            pendentes.push_back(anel[inicio]);
+            inicio = (inicio + 1) % anel.size();
+            --ocupados;
+        }
+        // Sincronização (ponto de controle): grava mesmo um bloco binário incompleto
+        const bool sincronizar = pedidoSincronizacao;
+        pedidoSincronizacao = false;
+        lock.unlock();
+        temEspaco.notify_all();
+
+        if (sincronizar || formato == FormatoRastro::CSV || pendentes.size() >= linhasPorBloco) gravarPendentes();
+        if (sincronizar) arquivo.flush();
+        lock.lock();
+        if (sincronizar) {
+            duraveis = gravadas;
+            sincronizado.notify_all();
+        }
+    }
+    lock.unlock();
+
+    gravarPendentes();
+    arquivo.flush();
+
+    lock.lock();
+    duraveis = gravadas;
+    terminou = true;
+    lock.unlock();
+    sincronizado.notify_all();
+}
+
+void GravadorRastro::gravarPendentes() {
+    if (pendentes.empty()) return;
+
+    if (formato == FormatoRastro::CSV) {
+        for (const auto& d : pendentes) {
+            arquivo << d.iteration << ","
+                    << d.temperature << ","
+                    << d.cost << ","
+                    << d.best_cost << ","
+                    << d.rung << ","
+                    << d.acceptance_rate << ","
+                    << d.swap_rate << ","
+                    << d.proposals << ","
+                    << d.accepted_uphill << ","
+                    << d.accepted_downhill << ","
+                    << d.new_best << ","
+                    << d.level_ns << "\n";
+        }
+    } else {
+        gravarBinario(arquivo, uint32_t(pendentes.size()));
+        gravarBinario(arquivo, uint32_t(0));
+        gravarColuna<int64_t>(arquivo, pendentes, &GraphData::iteration);
+        gravarColuna<double>(arquivo, pendentes, &GraphData::temperature);
+        gravarColuna<double>(arquivo, pendentes, &GraphData::cost);
+        gravarColuna<double>(arquivo, pendentes, &GraphData::best_cost);
+        gravarColuna<int32_t>(arquivo, pendentes, &GraphData::rung);
+        gravarColuna<double>(arquivo, pendentes, &GraphData::acceptance_rate);
+        gravarColuna<double>(arquivo, pendentes, &GraphData::swap_rate);
+        gravarColuna<int64_t>(arquivo, pendentes, &GraphData::proposals);
+        gravarColuna<int64_t>(arquivo, pendentes, &GraphData::accepted_uphill);
+        gravarColuna<int64_t>(arquivo, pendentes, &GraphData::accepted_downhill);
+        gravarColuna<int64_t>(arquivo, pendentes, &GraphData::new_best);
+        gravarColuna<int64_t>(arquivo, pendentes, &GraphData::level_ns);
+    }
+
+    gravadas += pendentes.size();
+    pendentes.clear();
+}
@@ -0,0 +1,45 @@
+#include "../include/Rota.hpp"
+#include "../include/FuncoesAuxiliares.hpp"
+#include <algorithm>
+
+Rota::Rota(const std::vector<int>& cidades)
+    : cidades(cidades), posicoes(cidades.size())
+{
+    atualizarPosicoes(0, size() - 1);
+}
+
+void Rota::atualizarPosicoes(int inicio, int fim) {
+    for (int p = inicio; p <= fim; ++p)
+        posicoes[cidades[p]] = p;
+}
+
+void Rota::aplicar(const Movimento& mov) {
+    int n = size();
+    aplicarMovimento(cidades, mov);
+
+    switch (mov.tipo) {
+        case TipoMovimento::Swap:
+            posicoes[cidades[mov.i]] = mov.i;
+            posicoes[cidades[mov.j]] = mov.j;
+            break;
+        case TipoMovimento::Insertion:
+            atualizarPosicoes(std::min(mov.i, mov.j), std::max(mov.i, mov.j));
+            break;
+        case TipoMovimento::TwoOpt: {
+            // Mesmo critério de aplicarMovimento para saber qual lado foi invertido
+            int dentro = mov.j - mov.i;
+            if (dentro <= n - dentro) {
+                atualizarPosicoes(mov.i + 1, mov.j);
+            } else {
+                atualizarPosicoes(mov.j + 1, n - 1);
+                atualizarPosicoes(0, mov.i);
+            }
+            break;
+        }
+        case TipoMovimento::OrOpt:
+            atualizarPosicoes(std::min(mov.i, mov.j + 1), std::max(mov.i + mov.k - 1, mov.j));
+            break;
+        default:
+            break;
+    }
+}
@@ -0,0 +1,358 @@
+#include "../include/RotaDuasCamadas.hpp"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
+RotaDuasCamadas::RotaDuasCamadas(const std::vector<int>& cidades) {
+    construir(cidades);
+}
+
+void RotaDuasCamadas::construir(const std::vector<int>& cidades) {
+    int n = cidades.size();
+    int numSeg = std::max(2, static_cast<int>(std::sqrt(static_cast<double>(n))));
+    numSeg = std::min(numSeg, std::max(1, n));
+    tamGrupo = std::max(1, n / numSeg);
+
+    nos.assign(n, {});
+    segmentos.assign(numSeg, {});
+
+    for (int s = 0; s < numSeg; ++s) {
+        int ini = static_cast<long long>(s) * n / numSeg;
+        int fim = static_cast<long long>(s + 1) * n / numSeg;
+
+        Segmento& seg = segmentos[s];
+        seg.invertido = false;
+        seg.primeiro = cidades[ini];
+        seg.ultimo = cidades[fim - 1];
+        seg.ordem = s;
+        seg.prox = (s + 1) % numSeg;
+        seg.ant = (s - 1 + numSeg) % numSeg;
+        seg.tam = fim - ini;
+
+        for (int p = ini; p < fim; ++p) {
+            No& no = nos[cidades[p]];
+            no.segmento = s;
+            no.seq = p - ini;
+            no.prox = (p + 1 < fim) ? cidades[p + 1] : -1;
+            no.ant = (p > ini) ? cidades[p - 1] : -1;
+        }
+    }
+    precisaRebalancear = false;
+}
+
+bool RotaDuasCamadas::entre(int a, int b, int c) const {
+    auto chave = [this](int x) { return std::make_pair(segmentos[nos[x].segmento].ordem, seqRota(x)); };
+    auto ka = chave(a), kb = chave(b), kc = chave(c);
+    if (ka <= kc) return ka <= kb && kb <= kc;
+    return kb >= ka || kb <= kc;
+}
+
+// [n, segmentos, tamGrupo, precisaRebalancear], 4 inteiros por nó e 7 por segmento
+std::vector<int> RotaDuasCamadas::salvarEstado() const {
+    std::vector<int> dados{static_cast<int>(nos.size()), static_cast<int>(segmentos.size()), tamGrupo,
+                           precisaRebalancear ? 1 : 0};
+    dados.reserve(4 + 4 * nos.size() + 7 * segmentos.size());
+    for (const No& no : nos) dados.insert(dados.end(), {no.segmento, no.seq, no.prox, no.ant});
+    for (const Segmento& seg : segmentos)
+        dados.insert(dados.end(), {seg.invertido ? 1 : 0, seg.primeiro, seg.ultimo, seg.ordem, seg.prox, seg.ant, seg.tam});
+    return dados;
+}
+
+void RotaDuasCamadas::restaurarEstado(const std::vector<int>& dados) {
+    if (dados.size() < 4 || dados.size() != 4 + 4 * size_t(dados[0]) + 7 * size_t(dados[1]))
+        throw std::runtime_error("Estado de rota em dois níveis inválido");
+    nos.resize(dados[0]);
+    segmentos.resize(dados[1]);
+    tamGrupo = dados[2];
+    precisaRebalancear = dados[3] != 0;
+    const int* d = dados.data() + 4;
+    for (No& no : nos) {
+        no = {d[0], d[1], d[2], d[3]};
+        d += 4;
+    }
+    for (Segmento& seg : segmentos) {
+        seg = {d[0] != 0, d[1], d[2], d[3], d[4], d[5], d[6]};
+        d += 7;
+    }
+}
+
+std::vector<int> RotaDuasCamadas::paraVetor() const {
+    std::vector<int> cidades;
+    if (nos.empty()) return cidades;
+    cidades.reserve(nos.size());
+
+    // Percorre segmento a segmento, seguindo os ponteiros armazenados sem testar as pontas
+    int s = 0;
+    do {
+        const Segmento& seg = segmentos[s];
+        if (!seg.invertido)
+            for (int c = seg.primeiro; c != -1; c = nos[c].prox) cidades.push_back(c);
+        else
+            for (int c = seg.ultimo; c != -1; c = nos[c].ant) cidades.push_back(c);
+        s = seg.prox;
+    } while (s != 0);
+    return cidades;
+}
+
+// ===== Divisão de segmentos =====
+
+// Faz de x a primeira cidade (no sentido da rota) do seu segmento, passando as cidades
+// anteriores a x para o fim do segmento anterior ou x e as seguintes para o início do
+// próximo, o que for menor. Nunca insere no início de segProibido.
+void RotaDuasCamadas::tornarInicio(int x, int segProibido) {
+    int s = nos[x].segmento;
+    if (inicioSeg(s) == x) return;
+
+    const Segmento& seg = segmentos[s];
+    int antes = seg.invertido ? nos[seg.ultimo].seq - nos[x].seq : nos[x].seq - nos[seg.primeiro].seq;
+    int depois = seg.tam - antes;
+    bool moverAntes = antes <= depois || seg.prox == segProibido;
+
+    std::vector<int> trecho;
+    if (moverAntes) {
+        trecho.reserve(antes);
+        for (int c = inicioSeg(s); c != x; c = proxima(c)) trecho.push_back(c);
+        moverParaFim(s, seg.ant, trecho);
+    } else {
+        trecho.reserve(depois);
+        int fim = fimSeg(s);
+        for (int c = x; ; c = proxima(c)) {
+            trecho.push_back(c);
+            if (c == fim) break;
+        }
+        moverParaInicio(s, seg.prox, trecho);
+    }
+}
+
+// trecho: cidades do início de origem, no sentido da rota; vão para o fim de destino
+void RotaDuasCamadas::moverParaFim(int origem, int destino, const std::vector<int>& trecho) {
+    Segmento& o = segmentos[origem];
+    int resto = proxima(trecho.back());
+    if (!o.invertido) {
+        o.primeiro = resto;
+        nos[resto].ant = -1;
+    } else {
+        o.ultimo = resto;
+        nos[resto].prox = -1;
+    }
+    o.tam -= trecho.size();
+
+    Segmento& d = segmentos[destino];
+    for (int c : trecho) {
+        No& no = nos[c];
+        no.segmento = destino;
+        if (!d.invertido) {
+            no.seq = nos[d.ultimo].seq + 1;
+            no.ant = d.ultimo;
+            no.prox = -1;
+            nos[d.ultimo].prox = c;
+            d.ultimo = c;
+        } else {
+            no.seq = nos[d.primeiro].seq - 1;
+            no.prox = d.primeiro;
+            no.ant = -1;
+            nos[d.primeiro].ant = c;
+            d.primeiro = c;
+        }
+    }
+    d.tam += trecho.size();
+    if (d.tam > 4 * tamGrupo) precisaRebalancear = true;
+}
+
+// trecho: cidades do fim de origem, no sentido da rota; vão para o início de destino
+void RotaDuasCamadas::moverParaInicio(int origem, int destino, const std::vector<int>& trecho) {
+    Segmento& o = segmentos[origem];
+    int resto = anterior(trecho.front());
+    if (!o.invertido) {
+        o.ultimo = resto;
+        nos[resto].prox = -1;
+    } else {
+        o.primeiro = resto;
+        nos[resto].ant = -1;
+    }
+    o.tam -= trecho.size();
+
+    Segmento& d = segmentos[destino];
+    for (auto it = trecho.rbegin(); it != trecho.rend(); ++it) {
+        int c = *it;
+        No& no = nos[c];
+        no.segmento = destino;
+        if (!d.invertido) {
+            no.seq = nos[d.primeiro].seq - 1;
+            no.prox = d.primeiro;
+            no.ant = -1;
+            nos[d.primeiro].ant = c;
+            d.primeiro = c;
+        } else {
+            no.seq = nos[d.ultimo].seq + 1;
+            no.ant = d.ultimo;
+            no.prox = -1;
+            nos[d.ultimo].prox = c;
+            d.ultimo = c;
+        }
+    }
+    d.tam += trecho.size();
+    if (d.tam > 4 * tamGrupo) precisaRebalancear = true;
+}
+
+// ===== Inversões =====
+
+// a e b no mesmo segmento, a antes de b no sentido da rota
+void RotaDuasCamadas::inverterNoSegmento(int a, int b) {
+    int s = nos[a].segmento;
+    Segmento& seg = segmentos[s];
+
+    // Segmento inteiro: basta trocar o bit de inversão
+    if (inicioSeg(s) == a && fimSeg(s) == b) {
+        seg.invertido = !seg.invertido;
+        return;
+    }
+
+    // Extremos na ordem armazenada
+    int u = seg.invertido ? b : a;
+    int w = seg.invertido ? a : b;
+    int antesU = nos[u].ant;
+    int depoisW = nos[w].prox;
+    int seqInicial = nos[u].seq;
+
+    std::vector<int> trecho;
+    for (int c = u; ; c = nos[c].prox) {
+        trecho.push_back(c);
+        if (c == w) break;
+    }
+    std::reverse(trecho.begin(), trecho.end());
+
+    int len = trecho.size();
+    for (int t = 0; t < len; ++t) {
+        No& no = nos[trecho[t]];
+        no.seq = seqInicial + t;
+        no.ant = (t == 0) ? antesU : trecho[t - 1];
+        no.prox = (t == len - 1) ? depoisW : trecho[t + 1];
+    }
+    if (antesU != -1) nos[antesU].prox = trecho.front();
+    else seg.primeiro = trecho.front();
+    if (depoisW != -1) nos[depoisW].ant = trecho.back();
+    else seg.ultimo = trecho.back();
+}
+
+// Inverte a sequência de segmentos inteiros de s1 até s2 (no sentido da rota)
+void RotaDuasCamadas::inverterSegmentos(int s1, int s2) {
+    int numSeg = segmentos.size();
+    int m = 1;
+    for (int s = s1; s != s2; s = segmentos[s].prox) ++m;
+
+    // Inverter o complemento dá o mesmo ciclo; escolhe-se o lado com menos segmentos
+    if (2 * m > numSeg) {
+        if (m == numSeg) return;
+        int c1 = segmentos[s2].prox;
+        int c2 = segmentos[s1].ant;
+        s1 = c1;
+        s2 = c2;
+        m = numSeg - m;
+    }
+
+    int antes = segmentos[s1].ant;
+    int depois = segmentos[s2].prox;
+
+    std::vector<int> lista;
+    std::vector<int> ordens;
+    lista.reserve(m);
+    ordens.reserve(m);
+    for (int s = s1; ; s = segmentos[s].prox) {
+        lista.push_back(s);
+        ordens.push_back(segmentos[s].ordem);
+        if (s == s2) break;
+    }
+
+    for (int s : lista) {
+        Segmento& seg = segmentos[s];
+        seg.invertido = !seg.invertido;
+        std::swap(seg.prox, seg.ant);
+    }
+    segmentos[antes].prox = s2;
+    segmentos[s2].ant = antes;
+    segmentos[s1].prox = depois;
+    segmentos[depois].ant = s1;
+
+    for (int t = 0; t < m; ++t)
+        segmentos[lista[m - 1 - t]].ordem = ordens[t];
+}
+
+void RotaDuasCamadas::inverter(int a, int b) {
+    if (a == b) return;
+
+    if (nos[a].segmento == nos[b].segmento) {
+        if (seqRota(a) <= seqRota(b)) {
+            inverterNoSegmento(a, b);
+        } else {
+            // O caminho dá a volta na rota; o complemento fica dentro do segmento
+            int x = proxima(b);
+            int y = anterior(a);
+            if (x != a) inverterNoSegmento(x, y);
+        }
+        return;
+    }
+
+    tornarInicio(a, -1);
+    if (nos[a].segmento == nos[b].segmento) {
+        inverterNoSegmento(a, b);
+    } else {
+        int x = proxima(b);
+        if (x == a) return;   // caminho é a rota inteira: o ciclo não muda
+        tornarInicio(x, nos[a].segmento);
+        inverterSegmentos(nos[a].segmento, nos[b].segmento);
+    }
+
+    if (precisaRebalancear) construir(paraVetor());
+}
+
+// Remove as arestas (t1, t2) e (t3, t4) e cria (t1, t3) e (t2, t4), com t2 e t4
+// sucessores (ou ambos antecessores) de t1 e t3
+void RotaDuasCamadas::trocarArestas(int t1, int t2, int t3, int t4) {
+    if (t2 == t3 || t1 == t4) return;
+    if (proxima(t1) == t2) inverter(t2, t3);
+    else inverter(t3, t2);
+}
+
+void RotaDuasCamadas::aplicar(const Movimento& mov) {
+    switch (mov.tipo) {
+        case TipoMovimento::Swap: {
+            int a = mov.a, b = mov.b;
+            if (proxima(b) == a) std::swap(a, b);
+            int pa = anterior(a), na = proxima(a);
+            int pb = anterior(b), nb = proxima(b);
+            if (na == b) {
+                trocarArestas(pa, a, b, nb);
+            } else {
+                trocarArestas(pa, a, b, nb);
+                trocarArestas(b, pb, na, a);
+            }
+            break;
+        }
+        case TipoMovimento::TwoOpt: {
+            int na = proxima(mov.a);
+            int nb = proxima(mov.b);
+            trocarArestas(mov.a, na, mov.b, nb);
+            break;
+        }
+        case TipoMovimento::Insertion:
+        case TipoMovimento::OrOpt: {
+            // Trecho s1..s2 entre p e q vai para entre u e v, em até três trocas de arestas
+            int k = (mov.tipo == TipoMovimento::Insertion) ? 1 : mov.k;
+            int s1 = mov.a;
+            int s2 = s1;
+            for (int t = 1; t < k; ++t) s2 = proxima(s2);
+            int p = anterior(s1), q = proxima(s2);
+            int u = mov.b, v = proxima(u);
+
+            trocarArestas(p, s1, u, v);     // p u ... q s2 ... s1 v
+            trocarArestas(p, u, q, s2);     // p q ... u s2 ... s1 v
+            if (!mov.invertido || mov.tipo == TipoMovimento::Insertion)
+                trocarArestas(u, s2, s1, v);    // u s1 ... s2 v
+            break;
+        }
+        default:
+            break;
+    }
+}
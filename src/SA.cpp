@@ -1,42 +1,200 @@
 #include "../include/SA.hpp"
 #include "../include/FuncoesAuxiliares.hpp"
+#include "../include/SAEspecializado.hpp"
+#include "../include/Especulacao.hpp"
+#include "../include/DiarioMovimentos.hpp"
+#include <algorithm>
 #include <cmath>
-#include <cstdlib>
 #include <iostream>
+#include <memory>
 
 std::vector<int> SA::executar() {
-    std::vector<int> melhorRota = gerarRotaInicial(instance);
-    double melhorCusto = calcularCusto(melhorRota, instance);
+    std::vector<int> rotaInicial = obterRotaInicial();
+    if (gerarVizinhaDuasCamadas && instance.getDimension() >= limiarDuasCamadas)
+        return executarCom(RotaDuasCamadas(rotaInicial), gerarVizinhaDuasCamadas);
+    return executarCom(Rota(rotaInicial), gerarVizinha);
+}
 
-    std::vector<int> rotaAtual = melhorRota;
+template <class RotaT, class Gerador>
+std::vector<int> SA::executarCom(RotaT rotaAtual, const Gerador& gerar) {
+    iniciarControle();
+    // Melhor rota pelo diário de movimentos: um novo melhor não copia a rota
+    DiarioMovimentos<RotaT> diario(rotaAtual);
+    double melhorCusto = calcularCusto(rotaAtual.paraVetor(), instance);
     double custoAtual = melhorCusto;
 
     double temperatura = temperaturaInicial;
-    int ctIteracao = 0;
+    int iterNivel = iteracoesPorTemperatura;
+    long long ctIteracao = 0;
+
+    // Cronograma adaptativo: T0 pelos deltas de propostas sobre a rota inicial (sem aplicá-las)
+    // e iterações por nível proporcionais a n; a parada é pela aceitação na janela
+    const bool adaptativo = cronograma == TipoCronograma::Adaptativo;
+    JanelaAceitacao janela(cronogramaAdaptativo.janelaNiveis);
+    if (adaptativo && !retomada) {
+        std::vector<double> deltasPiora;
+        for (int k = 0; k < cronogramaAdaptativo.amostras; ++k) {
+            double delta = gerar(rotaAtual, instance, rng).delta;
+            if (delta > 0) deltasPiora.push_back(delta);
+        }
+        temperatura = calibrarTemperaturaInicial(deltasPiora, cronogramaAdaptativo.aceitacaoInicial);
+        iterNivel = std::max(1, static_cast<int>(std::lround(cronogramaAdaptativo.iterPorCidade * instance.getDimension())));
+        if (verbose)
+            std::cout << "Cronograma adaptativo: T0 = " << temperatura << ", " << iterNivel << " iterações por nível\n";
+    }
+
+    // Avaliação especulativa, criada no primeiro nível com aceitação baixa
+    std::unique_ptr<AvaliadorEspeculativo<RotaT, Gerador>> especulador;
+    int aceitosNivel = iterNivel;
+
+    // Propostas em lote com os deltas calculados de uma vez (ver PropostasEmLote.hpp)
+    std::unique_ptr<DistanciasLote> distanciasLote;
+    std::unique_ptr<PropostasEmLote<RotaT>> lote;
+    if (modoPropostas != ModoPropostas::Sequencial && PropostasEmLote<RotaT>::suporta(tipoPropostas)) {
+        distanciasLote = std::make_unique<DistanciasLote>(instance);
+        lote = std::make_unique<PropostasEmLote<RotaT>>(*distanciasLote, tipoPropostas, modoPropostas, tamLotePropostas);
+    }
 
-    graph_data.clear();
+    iniciarRegistro();
 
-    while (temperatura > 1.0) { // critério de parada
-        for (int i = 0; i < iteracoesPorTemperatura; ++i) {
-            auto [novaRota, delta] = gerarVizinha(rotaAtual, custoAtual, instance);
-            double novoCusto = custoAtual + delta;
+    // Critério de parada: T <= 1 no geométrico, aceitação na janela no adaptativo
+    auto continuar = [&] {
+        return adaptativo ? !janela.abaixoDe(cronogramaAdaptativo.aceitacaoParada) : temperatura > 1.0;
+    };
 
-            if (delta < 0 || (std::exp(-delta / temperatura) > ((double) rand() / RAND_MAX))) {
-                rotaAtual = novaRota;
-                custoAtual = novoCusto;
+    long long proximaVerificacao = ControleExecucao::intervaloVerificacao;
+
+    // Retomada de um ponto de controle: o laço continua do nível seguinte ao gravado
+    if (retomada) {
+        restaurarEstado(*retomada, "SA");
+        restaurarRotas(*retomada, rotaAtual, diario);
+        temperatura = retomada->temperatura;
+        iterNivel = retomada->iterNivel;
+        ctIteracao = retomada->iteracao;
+        proximaVerificacao = retomada->proximaVerificacao;
+        aceitosNivel = retomada->aceitosNivel;
+        custoAtual = retomada->custoAtual;
+        melhorCusto = retomada->melhorCusto;
+        if (adaptativo) janela.restaurarEstado(retomada->janela);
+        retomada.reset();
+    }
+
+    // Orçamento, alvo e cancelamento: conferidos a cada intervaloVerificacao propostas e por nível
+    bool parar = interromper(ctIteracao, melhorCusto);
+
+    while (!parar && continuar()) {
+        // Com orçamento, o geométrico resfria mais rápido para terminar o cronograma dentro dele
+        const double taxa = adaptativo ? taxaResfriamento : taxaParaOrcamento(temperatura, 1.0, ctIteracao, iterNivel, taxaResfriamento);
+        bool especular = trabalhadoresEspeculacao > 1 && aceitosNivel < limiarEspeculacao * iterNivel;
+        if (especular && !especulador)
+            especulador = std::make_unique<AvaliadorEspeculativo<RotaT, Gerador>>(
+                gerar, instance, trabalhadoresEspeculacao, loteEspeculacao, rng);
+        aceitosNivel = 0;
+        contadores.iniciar();
+        const long long ctInicioNivel = ctIteracao;
+
+        for (int i = 0; i < iterNivel; ) {
+            Movimento mov;
+            bool aceito;
+            if (especular) {
+                int consumidas = especulador->avaliarLote(rotaAtual, temperatura, iterNivel - i, mov, aceito);
+                i += consumidas;
+                ctIteracao += consumidas;
+            } else if (lote) {
+                int consumidas = lote->avaliarLote(rotaAtual, temperatura, iterNivel - i, rng, mov, aceito);
+                i += consumidas;
+                ctIteracao += consumidas;
+            } else {
+                mov = gerar(rotaAtual, instance, rng);
+                // Metropolis na forma de limiar: u < exp(-delta/T)  <=>  delta < -T log(u)
+                aceito = mov.delta < 0 || mov.delta < temperatura * rng.exponencial();
+                ++i;
+                ++ctIteracao;
+            }
+
+            if (aceito) {
+                rotaAtual.aplicar(mov);
+                diario.registrar(mov);
+                custoAtual += mov.delta;
+                ++aceitosNivel;
+                contadores.aceito(mov.delta);
             }
 
             if (custoAtual < melhorCusto) {
-                melhorRota = rotaAtual;
+                diario.novaMelhor(rotaAtual);
                 melhorCusto = custoAtual;
+                contadores.novoMelhor();
+            }
+
+            if (ctIteracao >= proximaVerificacao) {
+                proximaVerificacao = ctIteracao + ControleExecucao::intervaloVerificacao;
+                if (interromper(ctIteracao, melhorCusto)) {
+                    parar = true;
+                    break;
+                }
+            }
+        }
+        temperatura *= taxa; // resfriamento
+        movimentosPropostos = ctIteracao;
+        contadores.proposta(ctIteracao - ctInicioNivel);
+        if (adaptativo) janela.registrar(aceitosNivel, ctIteracao - ctInicioNivel);
+        GraphData nivel{ctIteracao, temperatura, custoAtual, melhorCusto};
+        contadores.preencher(nivel);
+        registrarNivel(nivel);
+        informarProgresso(diario, melhorCusto);
+        if (!parar) parar = interromper(ctIteracao, melhorCusto);
+
+        // Modelo de ilhas: envia a melhor rota e adota a recebida se for melhor que a atual
+        if (migracao && niveisRegistrados % intervaloMigracao == 0) {
+            std::vector<int> recebida;
+            double custoRecebido;
+            if (migracao(diario.melhor().paraVetor(), melhorCusto, recebida, custoRecebido) && custoRecebido < custoAtual) {
+                rotaAtual = RotaT(recebida);
+                custoAtual = custoRecebido;
+                if (custoAtual < melhorCusto) {
+                    diario.reiniciar(rotaAtual);
+                    melhorCusto = custoAtual;
+                } else {
+                    diario.desviar();
+                }
             }
+        }
 
-            ctIteracao++;
+        if (!parar && pontoControleDevido()) {
+            EstadoExecucao estado;
+            preencherEstado(estado, "SA");
+            estado.temperatura = temperatura;
+            estado.iterNivel = iterNivel;
+            estado.iteracao = ctIteracao;
+            estado.proximaVerificacao = proximaVerificacao;
+            estado.aceitosNivel = aceitosNivel;
+            estado.custoAtual = custoAtual;
+            estado.melhorCusto = melhorCusto;
+            if (adaptativo) estado.janela = janela.salvarEstado();
+            enviarPontoControle(std::move(estado), rotaAtual, diario);
         }
-        temperatura *= taxaResfriamento; // resfriamento
-        graph_data.push_back({ctIteracao, temperatura, custoAtual, melhorCusto});
     }
 
-    std::cout << "Melhor custo encontrado: " << melhorCusto << std::endl;
+    // Busca local final sobre a melhor rota
+    std::vector<int> melhorRota = diario.melhor().paraVetor();
+    polir(melhorRota, melhorCusto);
+
+    if (verbose) {
+        std::cout << "Melhor custo encontrado: " << melhorCusto << std::endl;
+        if (motivoParada != MotivoParada::Cronograma) std::cout << "Parada: " << nomeMotivoParada(motivoParada) << "\n";
+        resumo.imprimir(std::cout);
+        resumoBuscaLocal.imprimir(std::cout);
+    }
+    concluirPontoControle();
     return melhorRota;
 }
+
+template <class Dist, TipoMovimento Tipo>
+std::vector<int> SAEspecializado<Dist, Tipo>::executar() {
+    std::vector<int> rotaInicial = this->obterRotaInicial();
+    if (this->instance.getDimension() >= this->limiarDuasCamadas)
+        return this->executarCom(RotaDuasCamadas(rotaInicial), vizinhanca);
+    return this->executarCom(Rota(rotaInicial), vizinhanca);
+}
+
+INSTANCIAR_NUCLEOS(SAEspecializado)
@@ -1,5 +1,9 @@
 #include "../include/SAReaquecimento.hpp"
 #include "../include/FuncoesAuxiliares.hpp"
+#include "../include/SAEspecializado.hpp"
+#include "../include/DiarioMovimentos.hpp"
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <functional>
 
@@ -9,64 +13,159 @@ SAReaquecimento::SAReaquecimento(
     const std::vector<double>& endTemp,
     const std::vector<double>& coolingRate,
     const std::vector<int>& maxIters,
-    VizinhancaFunc vizinhanca
+    VizinhancaFunc vizinhanca,
+    VizinhancaDuasCamadasFunc vizinhancaDuasCamadas
 ) : SimulatedAnnealing(instance, startTemp[0], coolingRate[0], maxIters[0]),
     startTemp(startTemp),
     endTemp(endTemp),
     coolingRate(coolingRate),
     maxIters(maxIters),
-    gerarVizinha(vizinhanca) {}
+    gerarVizinha(vizinhanca),
+    gerarVizinhaDuasCamadas(vizinhancaDuasCamadas) {}
     
 std::vector<int> SAReaquecimento::executar() {
-    int maxReheating = startTemp.size();
+    std::vector<int> rotaInicial = obterRotaInicial();
+    if (gerarVizinhaDuasCamadas && instance.getDimension() >= limiarDuasCamadas)
+        return executarCom(RotaDuasCamadas(rotaInicial), gerarVizinhaDuasCamadas);
+    return executarCom(Rota(rotaInicial), gerarVizinha);
+}
 
-    std::vector<int> melhorRota = gerarRotaInicial(instance);
-    double melhorCusto = calcularCusto(melhorRota, instance);
+template <class RotaT, class Gerador>
+std::vector<int> SAReaquecimento::executarCom(RotaT rotaAtual, const Gerador& gerar) {
+    iniciarControle();
+    int maxReheating = startTemp.size();
 
-    std::vector<int> rotaAtual = melhorRota;
+    // Melhor rota pelo diário de movimentos, materializada só ao fim das fases e sob demanda
+    DiarioMovimentos<RotaT> diario(rotaAtual);
+    double melhorCusto = calcularCusto(rotaAtual.paraVetor(), instance);
     double custoAtual = melhorCusto;
 
     int ctIteracao = 0;
-    graph_data.clear();
+    iniciarRegistro();
+
+    // Retomada de um ponto de controle: continua na fase e na temperatura gravadas
+    bool retomado = false;
+    int faseInicial = 0;
+    double temperaturaRetomada = 0.0;
+    if (retomada) {
+        retomado = true;
+        restaurarEstado(*retomada, "SAReaquecimento");
+        restaurarRotas(*retomada, rotaAtual, diario);
+        faseInicial = retomada->fase;
+        temperaturaRetomada = retomada->temperatura;
+        ctIteracao = static_cast<int>(retomada->iteracao);
+        custoAtual = retomada->custoAtual;
+        melhorCusto = retomada->melhorCusto;
+        retomada.reset();
+    }
+
+    // Propostas que faltam à fase a partir da temperatura t, no cronograma sem orçamento
+    auto propostasRestantes = [&](int f, double t) {
+        if (t <= endTemp[f]) return 0.0;
+        return std::ceil(std::log(endTemp[f] / t) / std::log(coolingRate[f])) * maxIters[f];
+    };
 
+    // Orçamento, alvo e cancelamento (ver ControleExecucao.hpp); com orçamento, o restante é
+    // dividido entre as fases na proporção das propostas que faltam a cada uma, e cada nível
+    // resfria para a fase caber na sua parte
+    bool parar = interromper(movimentosPropostos, melhorCusto);
 
-    for (int fase = 0; fase < maxReheating; ++fase) {
-        double temperatura = startTemp[fase];
+    for (int fase = faseInicial; fase < maxReheating && !parar; ++fase) {
+        double temperatura = retomado && fase == faseInicial ? temperaturaRetomada : startTemp[fase];
 
-        while (temperatura > endTemp[fase]) {
+        while (!parar && temperatura > endTemp[fase]) {
             ctIteracao++;
 
-            std::vector<int> melhorRotaFase;
+            double taxa = coolingRate[fase];
+            if (controle.temOrcamento()) {
+                double faltamFase = propostasRestantes(fase, temperatura), faltamTotal = faltamFase;
+                for (int f = fase + 1; f < maxReheating; ++f) faltamTotal += propostasRestantes(f, startTemp[f]);
+                taxa = taxaParaOrcamento(temperatura, endTemp[fase], movimentosPropostos, maxIters[fase],
+                                         coolingRate[fase], faltamFase / faltamTotal);
+            }
+
             double melhorCustoFase = -1;
+            contadores.iniciar();
+            int propostasNivel = maxIters[fase];
 
             for (int i = 0; i < maxIters[fase]; ++i) {
                 // Use vizinha com delta
-                auto [novaRota, delta] = gerarVizinha(rotaAtual, custoAtual, instance);
+                Movimento mov = gerar(rotaAtual, instance, rng);
+                double delta = mov.delta;
                 double novoCusto = custoAtual + delta;
 
-                if (melhorCustoFase == -1 || delta < 0 || (std::exp(-delta / temperatura) > ((double) rand() / RAND_MAX))) {
-                    rotaAtual = novaRota;
+                if (melhorCustoFase == -1 || delta < 0 || delta < temperatura * rng.exponencial()) {
+                    rotaAtual.aplicar(mov);
+                    diario.registrar(mov);
                     custoAtual = novoCusto;
+                    contadores.aceito(delta);
 
-                    if (melhorCustoFase == -1 || novoCusto < melhorCustoFase) {
-                        melhorRotaFase = rotaAtual;
-                        melhorCustoFase = custoAtual;
+                    if (melhorCustoFase == -1 || novoCusto < melhorCustoFase) melhorCustoFase = custoAtual;
+                    if (novoCusto < melhorCusto) {
+                        diario.novaMelhor(rotaAtual);
+                        melhorCusto = novoCusto;
+                        contadores.novoMelhor();
                     }
                 }
+
+                if ((i + 1) % ControleExecucao::intervaloVerificacao == 0 &&
+                    interromper(movimentosPropostos + i + 1, melhorCusto)) {
+                    parar = true;
+                    propostasNivel = i + 1;
+                    break;
+                }
             }
 
-            if (melhorCustoFase < melhorCusto) {
-                melhorRota = melhorRotaFase;
-                melhorCusto = melhorCustoFase;
+            temperatura *= taxa;
+            movimentosPropostos += propostasNivel;
+            contadores.proposta(propostasNivel);
+            GraphData nivel{ctIteracao, temperatura, melhorCustoFase, melhorCusto};
+            contadores.preencher(nivel);
+            registrarNivel(nivel);
+            informarProgresso(diario, melhorCusto);
+            if (!parar) parar = interromper(movimentosPropostos, melhorCusto);
+
+            if (!parar && pontoControleDevido()) {
+                EstadoExecucao estado;
+                preencherEstado(estado, "SAReaquecimento");
+                estado.fase = fase;
+                estado.temperatura = temperatura;
+                estado.iteracao = ctIteracao;
+                estado.custoAtual = custoAtual;
+                estado.melhorCusto = melhorCusto;
+                enviarPontoControle(std::move(estado), rotaAtual, diario);
             }
-            temperatura *= coolingRate[fase];
-            graph_data.push_back({ctIteracao, temperatura, melhorCustoFase, melhorCusto});
         }
 
-        std::cout << "Reaquecimento aplicado. Nova temperatura: " << startTemp[fase] << std::endl;
+        // Busca local na melhor rota ao fim da fase (a da última fase é a final); a próxima fase
+        // parte da rota polida
+        if (buscaLocalAtiva) {
+            std::vector<int> polida = diario.melhor().paraVetor();
+            polir(polida, melhorCusto);
+            rotaAtual = RotaT(polida);
+            custoAtual = melhorCusto;
+            diario.reiniciar(rotaAtual);
+        }
+
+        if (verbose) std::cout << "Reaquecimento aplicado. Nova temperatura: " << startTemp[fase] << std::endl;
+    }
+
+    if (verbose) {
+        std::cout << "Melhor custo encontrado: " << melhorCusto << std::endl;
+        if (motivoParada != MotivoParada::Cronograma) std::cout << "Parada: " << nomeMotivoParada(motivoParada) << "\n";
+        resumo.imprimir(std::cout);
+        resumoBuscaLocal.imprimir(std::cout);
     }
+    concluirPontoControle();
+    return diario.melhor().paraVetor();
+}
 
-    std::cout << "Melhor custo encontrado: " << melhorCusto << std::endl;
-    return melhorRota;
+template <class Dist, TipoMovimento Tipo>
+std::vector<int> SAReaquecimentoEspecializado<Dist, Tipo>::executar() {
+    std::vector<int> rotaInicial = this->obterRotaInicial();
+    if (this->instance.getDimension() >= this->limiarDuasCamadas)
+        return this->executarCom(RotaDuasCamadas(rotaInicial), vizinhanca);
+    return this->executarCom(Rota(rotaInicial), vizinhanca);
 }
 
+INSTANCIAR_NUCLEOS(SAReaquecimentoEspecializado)
@@ -0,0 +1,176 @@
+#include "../include/SATrocaReplicas.hpp"
+#include "../include/SAEspecializado.hpp"
+#include "../include/PoolThreads.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+SATrocaReplicas::SATrocaReplicas(const TSPInstance& instance, int numReplicas, double tempMin, double tempMax,
+                                 int iteracoesPorTroca, int numTrocas, int numThreads,
+                                 VizinhancaFunc vizinhanca, VizinhancaDuasCamadasFunc vizinhancaDuasCamadas)
+    : SimulatedAnnealing(instance, tempMax, numReplicas > 1 ? std::pow(tempMin / tempMax, 1.0 / (numReplicas - 1)) : 1.0,
+                         iteracoesPorTroca),
+      numReplicas(std::max(1, numReplicas)),
+      tempMin(tempMin),
+      tempMax(tempMax),
+      numTrocas(numTrocas),
+      numThreads(numThreads),
+      gerarVizinha(vizinhanca),
+      gerarVizinhaDuasCamadas(vizinhancaDuasCamadas) {}
+
+std::vector<double> SATrocaReplicas::getTemperaturas() const {
+    std::vector<double> temperaturas(numReplicas);
+    for (int k = 0; k < numReplicas; ++k)
+        temperaturas[k] = numReplicas > 1 ? tempMin * std::pow(tempMax / tempMin, double(k) / (numReplicas - 1)) : tempMin;
+    return temperaturas;
+}
+
+std::vector<int> SATrocaReplicas::executar() {
+    if (gerarVizinhaDuasCamadas && instance.getDimension() >= limiarDuasCamadas)
+        return executarCom<RotaDuasCamadas>(gerarVizinhaDuasCamadas);
+    return executarCom<Rota>(gerarVizinha);
+}
+
+template <class RotaT, class Gerador>
+std::vector<int> SATrocaReplicas::executarCom(const Gerador& gerar) {
+    // O melhor de cada réplica fica no diário, sem cópia da rota a cada melhora (ver DiarioMovimentos.hpp)
+    struct Replica {
+        RotaT rota;
+        double custo;
+        DiarioMovimentos<RotaT> diario;
+        double melhorCusto;
+        Rng rng;
+    };
+
+    const int K = numReplicas;
+    const std::vector<double> temperaturas = getTemperaturas();
+
+    // Cada réplica tem rota inicial e gerador próprios, semeados pelo gerador do solver,
+    // de modo que o resultado não depende da ordem de execução das threads
+    std::vector<Replica> replicas;
+    replicas.reserve(K);
+    for (int r = 0; r < K; ++r) {
+        Rng rngReplica(rng.proximo());
+        std::vector<int> inicial = obterRotaInicial(rngReplica);
+        double custo = calcularCusto(inicial, instance);
+        replicas.push_back({RotaT(inicial), custo, DiarioMovimentos<RotaT>(RotaT(inicial)), custo, rngReplica});
+    }
+
+    // naTemperatura[k]: réplica no degrau k
+    std::vector<int> naTemperatura(K);
+    for (int k = 0; k < K; ++k) naTemperatura[k] = k;
+
+    // Linha de cada degrau, com os contadores preenchidos ao fim da tarefa (o tempo é só o da
+    // réplica); trocas por par de degraus vizinhos, o par k sendo (k, k+1)
+    std::vector<long long> aceitosRodada(K, 0);
+    std::vector<GraphData> niveis(K);
+    std::vector<long long> trocasTentadas(K, 0), trocasAceitas(K, 0);
+
+    std::vector<int> melhorRota = replicas[0].diario.melhor().paraVetor();
+    double melhorCusto = replicas[0].melhorCusto;
+
+    PoolThreads pool(std::min(numThreads > 0 ? numThreads : K, K));
+    iniciarRegistro();
+    iniciarControle();
+
+    for (int rodada = 0; rodada < numTrocas; ++rodada) {
+        for (int k = 0; k < K; ++k) {
+            pool.enviar([&, k] {
+                Replica& rep = replicas[naTemperatura[k]];
+                const double temperatura = temperaturas[k];
+                ContadoresNivel cont;
+                long long aceitos = 0;
+                cont.iniciar();
+
+                for (int i = 0; i < iteracoesPorTemperatura; ++i) {
+                    Movimento mov = gerar(rep.rota, instance, rep.rng);
+                    double delta = mov.delta;
+
+                    if (delta < 0 || delta < temperatura * rep.rng.exponencial()) {
+                        rep.rota.aplicar(mov);
+                        rep.diario.registrar(mov);
+                        rep.custo += delta;
+                        ++aceitos;
+                        cont.aceito(delta);
+                    }
+
+                    if (rep.custo < rep.melhorCusto) {
+                        rep.diario.novaMelhor(rep.rota);
+                        rep.melhorCusto = rep.custo;
+                        cont.novoMelhor();
+                    }
+                }
+                cont.proposta(iteracoesPorTemperatura);
+                cont.preencher(niveis[k]);
+                aceitosRodada[k] = aceitos;
+            });
+        }
+        pool.aguardar();
+
+        for (Replica& rep : replicas) {
+            if (rep.melhorCusto < melhorCusto) {
+                melhorCusto = rep.melhorCusto;
+                melhorRota = rep.diario.melhor().paraVetor();
+            }
+        }
+
+        // Trocas entre degraus vizinhos, pares (0,1), (2,3)... e ímpares (1,2), (3,4)... alternados
+        for (int k = rodada % 2; k + 1 < K; k += 2) {
+            double fria = replicas[naTemperatura[k]].custo;
+            double quente = replicas[naTemperatura[k + 1]].custo;
+            double expoente = (1.0 / temperaturas[k] - 1.0 / temperaturas[k + 1]) * (fria - quente);
+
+            ++trocasTentadas[k];
+            if (expoente >= 0 || -expoente < rng.exponencial()) {
+                std::swap(naTemperatura[k], naTemperatura[k + 1]);
+                ++trocasAceitas[k];
+            }
+        }
+
+        int ctIteracao = (rodada + 1) * iteracoesPorTemperatura;
+        movimentosPropostos += static_cast<long long>(K) * iteracoesPorTemperatura;
+        for (int k = 0; k < K; ++k) {
+            // Taxa do degrau: trocas aceitas sobre tentadas com os dois vizinhos
+            long long tentadas = trocasTentadas[k] + (k > 0 ? trocasTentadas[k - 1] : 0);
+            long long aceitas = trocasAceitas[k] + (k > 0 ? trocasAceitas[k - 1] : 0);
+            double taxaTroca = tentadas ? double(aceitas) / tentadas : 0.0;
+            GraphData& nivel = niveis[k];
+            nivel.iteration = ctIteracao;
+            nivel.temperature = temperaturas[k];
+            nivel.cost = replicas[naTemperatura[k]].custo;
+            nivel.best_cost = melhorCusto;
+            nivel.rung = k;
+            nivel.acceptance_rate = double(aceitosRodada[k]) / iteracoesPorTemperatura;
+            nivel.swap_rate = taxaTroca;
+            registrarNivel(nivel);
+        }
+
+        // Controle da execução a cada rodada (as réplicas não são interrompidas no meio dela)
+        informarProgresso(melhorRota, melhorCusto);
+        if (interromper(movimentosPropostos, melhorCusto)) break;
+    }
+
+    // Busca local final sobre a melhor rota entre as réplicas
+    polir(melhorRota, melhorCusto);
+
+    if (verbose) {
+        std::cout << "Réplicas: " << K << " em " << pool.size() << " threads\n";
+        for (int k = 0; k + 1 < K; ++k)
+            std::cout << "  T = " << temperaturas[k] << " <-> " << temperaturas[k + 1] << ": taxa de troca "
+                      << (trocasTentadas[k] ? double(trocasAceitas[k]) / trocasTentadas[k] : 0.0) << "\n";
+        std::cout << "Melhor custo encontrado: " << melhorCusto << std::endl;
+        if (motivoParada != MotivoParada::Cronograma) std::cout << "Parada: " << nomeMotivoParada(motivoParada) << "\n";
+        resumo.imprimir(std::cout);
+        resumoBuscaLocal.imprimir(std::cout);
+    }
+    return melhorRota;
+}
+
+template <class Dist, TipoMovimento Tipo>
+std::vector<int> SATrocaReplicasEspecializado<Dist, Tipo>::executar() {
+    if (this->instance.getDimension() >= this->limiarDuasCamadas)
+        return this->template executarCom<RotaDuasCamadas>(vizinhanca);
+    return this->template executarCom<Rota>(vizinhanca);
+}
+
+INSTANCIAR_NUCLEOS(SATrocaReplicasEspecializado)
@@ -1,4 +1,27 @@
 #include "../include/SimulatedAnnealing.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+// Primeira linha "chave=valor" que difere entre as duas configurações
+std::string primeiraDiferenca(const std::string& gravada, const std::string& atual) {
+    std::istringstream a(gravada), b(atual);
+    std::string linhaA, linhaB;
+    for (;;) {
+        bool temA = static_cast<bool>(std::getline(a, linhaA));
+        bool temB = static_cast<bool>(std::getline(b, linhaB));
+        if (!temA && !temB) return "";
+        if (!temA) return "(nenhuma) em vez de " + linhaB;
+        if (!temB) return linhaA + " em vez de (nenhuma)";
+        if (linhaA != linhaB) return linhaA + " em vez de " + linhaB;
+    }
+}
+
+}
 
 SimulatedAnnealing::SimulatedAnnealing(const TSPInstance& instance, double tempInicial,
                                        double taxaResfriamento, int iterPorTemp)
@@ -9,3 +32,102 @@ SimulatedAnnealing::SimulatedAnnealing(const TSPInstance& instance, double tempI
 {}
 
 SimulatedAnnealing::~SimulatedAnnealing() = default;
+
+void SimulatedAnnealing::preencherEstado(EstadoExecucao& estado, const char* algoritmo) const {
+    estado.algoritmo = algoritmo;
+    estado.instancia = instance.getName();
+    estado.dimensao = instance.getDimension();
+    estado.configuracao = configuracaoPontoControle;
+    estado.movimentosPropostos = movimentosPropostos;
+    estado.niveisRegistrados = niveisRegistrados;
+    estado.posicaoRastro = rastro ? rastro->posicao() : niveisRegistrados;
+    if (rastro) estado.decimacao = rastro->salvarDecimacao();
+    estado.segundos = segundosDecorridos();
+    estado.resumo = resumo;
+    estado.rng = rng.estado();
+}
+
+void SimulatedAnnealing::restaurarEstado(const EstadoExecucao& estado, const char* algoritmo) {
+    if (estado.algoritmo != algoritmo || estado.instancia != instance.getName() ||
+        estado.dimensao != instance.getDimension())
+        throw std::runtime_error("Ponto de controle de outra execução: " + estado.algoritmo + " em " + estado.instancia);
+    if (estado.configuracao != configuracaoPontoControle)
+        throw std::runtime_error("Ponto de controle com outros parâmetros: " +
+                                 primeiraDiferenca(estado.configuracao, configuracaoPontoControle));
+    movimentosPropostos = estado.movimentosPropostos;
+    niveisRegistrados = estado.niveisRegistrados;
+    resumo = estado.resumo;
+    if (rastro) rastro->restaurarDecimacao(estado.decimacao);
+    rng.restaurar(estado.rng);
+    inicioExecucao -= std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(estado.segundos));
+    ultimoPontoControle = estado.segundos;
+}
+
+void SimulatedAnnealing::concluirPontoControle() {
+    if (pontoControle && motivoParada != MotivoParada::Cancelado) pontoControle->concluir();
+}
+
+void SimulatedAnnealing::polir(std::vector<int>& rota, double& custo) {
+    if (!buscaLocalAtiva || motivoParada == MotivoParada::Cancelado ||
+        motivoParada == MotivoParada::TempoLimite || motivoParada == MotivoParada::IteracoesLimite)
+        return;
+
+    auto inicio = std::chrono::steady_clock::now();
+    // Com limite de tempo, a busca termina nele (e nem começa, nem monta as listas, se já passou)
+    auto prazo = std::chrono::steady_clock::time_point::max();
+    if (controle.tempoLimite > 0)
+        prazo = inicioExecucao + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                                     std::chrono::duration<double>(controle.tempoLimite));
+    if (inicio >= prazo) return;
+    if (!buscaLocal) buscaLocal = std::make_unique<BuscaLocal>(instance, candidatosBuscaLocal);
+    double antes = custo;
+    resumoBuscaLocal.movimentos += buscaLocal->otimizar(rota, custo, prazo);
+    resumoBuscaLocal.melhoria += antes - custo;
+    resumoBuscaLocal.segundos += std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count();
+    ++resumoBuscaLocal.chamadas;
+}
+
+std::vector<int> SimulatedAnnealing::obterRotaInicial(Rng& gerador) {
+    if (!rotaFixada.empty()) return rotaFixada;
+    if (construcaoInicial == TipoRotaInicial::Aleatoria) return gerarRotaInicial(instance, gerador);
+
+    auto inicio = std::chrono::steady_clock::now();
+    std::vector<int> rota = construirRotaInicial(instance, construcaoInicial, gerador, candidatosConstrucao);
+    if (verbose)
+        std::cout << "Rota inicial (" << nomeRotaInicial(construcaoInicial) << "): custo "
+                  << calcularCustoTotal(instance, rota) << " em "
+                  << std::chrono::duration<double>(std::chrono::steady_clock::now() - inicio).count()
+                  << " segundos\n";
+    return rota;
+}
+
+bool SimulatedAnnealing::interromper(long long iteracoes, double melhorCusto) {
+    if (cancelamento.load(std::memory_order_relaxed)) motivoParada = MotivoParada::Cancelado;
+    else if (melhorCusto <= controle.custoAlvo) motivoParada = MotivoParada::CustoAlvo;
+    else if (controle.iteracoesLimite > 0 && iteracoes >= controle.iteracoesLimite) motivoParada = MotivoParada::IteracoesLimite;
+    else if (controle.tempoLimite > 0 && segundosDecorridos() >= controle.tempoLimite) motivoParada = MotivoParada::TempoLimite;
+    else return false;
+    return true;
+}
+
+double SimulatedAnnealing::taxaParaOrcamento(double temperatura, double temperaturaFinal, long long iteracoes,
+                                             int iterNivel, double taxa, double fracao) const {
+    if (!controle.comprimirCronograma || !controle.temOrcamento() || temperatura <= temperaturaFinal)
+        return taxa;
+
+    double niveis = std::numeric_limits<double>::infinity();
+    if (controle.iteracoesLimite > 0)
+        niveis = fracao * double(controle.iteracoesLimite - iteracoes) / iterNivel;
+    if (controle.tempoLimite > 0 && iteracoes > 0) {
+        double decorrido = segundosDecorridos();
+        // Planeja para 95% do tempo: a parada rígida no limite fica só como garantia
+        double segundosPorNivel = decorrido / iteracoes * iterNivel;
+        niveis = std::min(niveis, fracao * (0.95 * controle.tempoLimite - decorrido) / segundosPorNivel);
+    }
+    niveis = std::max(niveis, 1.0);
+
+    double necessarios = std::log(temperaturaFinal / temperatura) / std::log(taxa);
+    if (necessarios <= niveis) return taxa;
+    return std::pow(temperaturaFinal / temperatura, 1.0 / niveis);
+}